@@ -0,0 +1,210 @@
+#include "network/frame_codec_adapter.h"
+#include "network/frame_codec_delimiter.h"
+#include "network/frame_codec_length.h"
+#include "network/frame_codec_simple.h"
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <vector>
+
+using sdk::net::DelimiterCodec;
+using sdk::net::FrameCodecAdapter;
+using sdk::net::IFrameCodec;
+using sdk::net::LengthPrefixCodec;
+using sdk::net::MagicFrameCodec;
+using sdk::net::SimpleMagicCodec;
+using sdk::net::VarintLengthCodec;
+
+// Count heap allocations so the decode loops can report allocs per frame
+static std::atomic<size_t> g_allocs{0};
+
+void *operator new(size_t size) {
+  g_allocs.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  std::free(p);
+}
+
+// SimpleMagicCodec as it was before the read offset: erase() after every
+// frame and one byte at a time on resync
+class VectorEraseMagicCodec {
+ public:
+  static constexpr uint16_t kMagic = 0xABCD;
+
+  void append(const uint8_t *data, size_t len) {
+    buf_.insert(buf_.end(), data, data + len);
+  }
+
+  std::optional<std::vector<uint8_t>> tryDecode() {
+    while (true) {
+      if (buf_.size() < 6) return std::nullopt;
+      uint16_t magic = (uint16_t(buf_[0]) << 8) | (uint16_t(buf_[1]) << 0);
+      if (magic != kMagic) {
+        buf_.erase(buf_.begin());
+        continue;
+      }
+      uint32_t len = (uint32_t(buf_[2]) << 24) | (uint32_t(buf_[3]) << 16) |
+                     (uint32_t(buf_[4]) << 8) | (uint32_t(buf_[5]));
+      if (buf_.size() < 6 + len) return std::nullopt;
+      std::vector<uint8_t> out(buf_.begin() + 6, buf_.begin() + 6 + len);
+      buf_.erase(buf_.begin(), buf_.begin() + 6 + len);
+      return out;
+    }
+  }
+
+ private:
+  std::vector<uint8_t> buf_;
+};
+
+// Up to 4 KiB of back to back whole frames with the given payload size
+static std::vector<uint8_t> SmallFrames(size_t payload) {
+  std::vector<uint8_t> stream;
+  std::vector<uint8_t> body(payload, 'x');
+  while (stream.size() + 6 + payload <= 4096) {
+    auto f = SimpleMagicCodec().encode(body.data(), body.size());
+    stream.insert(stream.end(), f.begin(), f.end());
+  }
+  return stream;
+}
+
+// Up to 4 KiB of back to back whole frames encoded by codec
+template <typename Codec>
+static std::vector<uint8_t> Frames(const Codec &codec, size_t payload) {
+  std::vector<uint8_t> stream;
+  std::vector<uint8_t> frame;
+  const std::vector<uint8_t> body(payload, 'x');
+  while (true) {
+    frame.clear();
+    codec.encode(body, frame);
+    if (stream.size() + frame.size() > 4096) return stream;
+    stream.insert(stream.end(), frame.begin(), frame.end());
+  }
+}
+
+template <typename Codec>
+static void BM_DecodeSmallFrames(benchmark::State &state) {
+  const auto read = SmallFrames(state.range(0));
+  Codec codec;
+  size_t frames = 0;
+  const size_t allocs = g_allocs.load();
+  for (auto _ : state) {
+    codec.append(read.data(), read.size());
+    while (auto frame = codec.tryDecode()) {
+      benchmark::DoNotOptimize(frame->data());
+      ++frames;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * read.size());
+  state.SetItemsProcessed(frames);
+  state.counters["allocs_per_frame"] =
+      static_cast<double>(g_allocs.load() - allocs) / frames;
+}
+
+// Framing in place, as sessions do with MessageView handlers
+static void BM_DecodeViewSmallFrames(benchmark::State &state) {
+  const auto read = SmallFrames(state.range(0));
+  SimpleMagicCodec codec;
+  size_t frames = 0;
+  const size_t allocs = g_allocs.load();
+  for (auto _ : state) {
+    std::span<const uint8_t> data(read);
+    while (true) {
+      auto frame = codec.decodeView(data);
+      data = data.subspan(frame.consumed);
+      if (!frame.payload) break;
+      benchmark::DoNotOptimize(frame.payload->data());
+      ++frames;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * read.size());
+  state.SetItemsProcessed(frames);
+  state.counters["allocs_per_frame"] =
+      static_cast<double>(g_allocs.load() - allocs) / frames;
+}
+
+// A read of small frames through IFrameCodec: one virtual decodeView() per
+// frame, as sessions did, against one decodeBatch() per read
+template <typename Codec>
+static void BM_VirtualDecodeView(benchmark::State &state) {
+  const auto read = Frames(Codec(), state.range(0));
+  std::unique_ptr<IFrameCodec> codec =
+      std::make_unique<FrameCodecAdapter<Codec>>();
+  size_t frames = 0;
+  for (auto _ : state) {
+    std::span<const uint8_t> data(read);
+    while (true) {
+      auto frame = codec->decodeView(data);
+      data = data.subspan(frame.consumed);
+      if (!frame.payload) break;
+      benchmark::DoNotOptimize(frame.payload->data());
+      ++frames;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * read.size());
+  state.SetItemsProcessed(frames);
+}
+
+template <typename Codec>
+static void BM_DecodeBatch(benchmark::State &state) {
+  const auto read = Frames(Codec(), state.range(0));
+  std::unique_ptr<IFrameCodec> codec =
+      std::make_unique<FrameCodecAdapter<Codec>>();
+  size_t frames = 0;
+  auto sink = [&](std::span<const uint8_t> payload) {
+    benchmark::DoNotOptimize(payload.data());
+    ++frames;
+  };
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(codec->decodeBatch(read, sink));
+  }
+  state.SetBytesProcessed(state.iterations() * read.size());
+  state.SetItemsProcessed(frames);
+}
+
+// Garbage of the given size in front of one frame, e.g. after a corrupted
+// write or when joining a stream in the middle
+template <typename Codec>
+static void BM_Resync(benchmark::State &state) {
+  std::vector<uint8_t> read(state.range(0));
+  for (size_t i = 0; i < read.size(); ++i) read[i] = uint8_t(i * 31);
+  const uint8_t payload[16] = {};
+  auto f = SimpleMagicCodec().encode(payload, sizeof(payload));
+  read.insert(read.end(), f.begin(), f.end());
+
+  for (auto _ : state) {
+    Codec codec;
+    codec.append(read.data(), read.size());
+    auto frame = codec.tryDecode();
+    benchmark::DoNotOptimize(frame);
+  }
+  state.SetBytesProcessed(state.iterations() * read.size());
+}
+
+BENCHMARK(BM_DecodeSmallFrames<VectorEraseMagicCodec>)->Arg(16)->Arg(64);
+BENCHMARK(BM_DecodeSmallFrames<SimpleMagicCodec>)->Arg(16)->Arg(64);
+BENCHMARK(BM_DecodeViewSmallFrames)->Arg(16)->Arg(64);
+BENCHMARK(BM_VirtualDecodeView<MagicFrameCodec>)->Arg(16);
+BENCHMARK(BM_DecodeBatch<MagicFrameCodec>)->Arg(16);
+BENCHMARK(BM_VirtualDecodeView<LengthPrefixCodec<uint16_t>>)->Arg(16);
+BENCHMARK(BM_DecodeBatch<LengthPrefixCodec<uint16_t>>)->Arg(16);
+BENCHMARK(BM_VirtualDecodeView<VarintLengthCodec>)->Arg(16);
+BENCHMARK(BM_DecodeBatch<VarintLengthCodec>)->Arg(16);
+BENCHMARK(BM_VirtualDecodeView<DelimiterCodec>)->Arg(16);
+BENCHMARK(BM_DecodeBatch<DelimiterCodec>)->Arg(16);
+BENCHMARK(BM_Resync<VectorEraseMagicCodec>)->Arg(1 << 10)->Arg(1 << 14);
+BENCHMARK(BM_Resync<SimpleMagicCodec>)->Arg(1 << 10)->Arg(1 << 14);
+
+BENCHMARK_MAIN();
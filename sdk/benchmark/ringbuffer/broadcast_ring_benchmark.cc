@@ -0,0 +1,132 @@
+#include "container/broadcast_ring.hpp"
+#include "container/spsc_ringbuffer.hpp"
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+using sdk::container::BroadcastRing;
+using sdk::container::SPSCRingbuffer;
+
+struct alignas(64) Msg64 {
+  uint64_t t{0};
+  uint8_t payload[56]{};
+};
+
+inline bool try_yield() {
+#ifdef __x86_64__
+  _mm_pause();
+#else
+  std::this_thread::yield();
+#endif
+  return true;
+}
+
+constexpr size_t kQueueCap = 8192;
+constexpr size_t kMsgsPerIter = 1 << 18;
+constexpr size_t kPopBatch = 64;
+
+// 绑定 CPU
+static void pin_to_cpu_optional(int cpu) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+// range(0): number of consumers, all reading the one shared ring
+static void BM_FanOut_Broadcast(benchmark::State &st) {
+  const int consumers = static_cast<int>(st.range(0));
+  const int ncpu = static_cast<int>(std::thread::hardware_concurrency());
+
+  BroadcastRing<Msg64> ring(kQueueCap);
+  std::vector<BroadcastRing<Msg64>::Consumer *> cons;
+  for (int c = 0; c < consumers; ++c) cons.push_back(ring.add_consumer());
+
+  for (auto _ : st) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for (int c = 0; c < consumers; ++c) {
+      workers.emplace_back([&, c] {
+        if (ncpu > 0) pin_to_cpu_optional((c + 1) % ncpu);
+        while (!go.load(std::memory_order_acquire)) try_yield();
+        uint64_t sum = 0;
+        size_t seen = 0;
+        while (seen < kMsgsPerIter) {
+          const size_t n = cons[c]->consume(
+              [&](const Msg64 &m) { sum += m.t; }, kPopBatch);
+          if (n == 0) try_yield();
+          seen += n;
+        }
+        benchmark::DoNotOptimize(sum);
+      });
+    }
+
+    go.store(true, std::memory_order_release);
+    Msg64 msg{};
+    for (size_t i = 0; i < kMsgsPerIter; ++i) {
+      msg.t = i;
+      while (!ring.try_push(msg)) try_yield();
+    }
+    for (auto &t : workers) t.join();
+  }
+
+  st.SetItemsProcessed(st.iterations() * kMsgsPerIter);
+}
+
+// range(0): number of consumers, one SPSC ring and one copy per consumer
+static void BM_FanOut_SPSCPerConsumer(benchmark::State &st) {
+  const int consumers = static_cast<int>(st.range(0));
+  const int ncpu = static_cast<int>(std::thread::hardware_concurrency());
+
+  std::vector<std::unique_ptr<SPSCRingbuffer<Msg64>>> rings;
+  for (int c = 0; c < consumers; ++c) {
+    rings.push_back(std::make_unique<SPSCRingbuffer<Msg64>>(kQueueCap));
+  }
+
+  for (auto _ : st) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for (int c = 0; c < consumers; ++c) {
+      workers.emplace_back([&, c] {
+        if (ncpu > 0) pin_to_cpu_optional((c + 1) % ncpu);
+        while (!go.load(std::memory_order_acquire)) try_yield();
+        Msg64 buf[kPopBatch];
+        uint64_t sum = 0;
+        size_t seen = 0;
+        while (seen < kMsgsPerIter) {
+          const size_t n = rings[c]->pop_n(buf, kPopBatch);
+          if (n == 0) try_yield();
+          for (size_t i = 0; i < n; ++i) sum += buf[i].t;
+          seen += n;
+        }
+        benchmark::DoNotOptimize(sum);
+      });
+    }
+
+    go.store(true, std::memory_order_release);
+    Msg64 msg{};
+    for (size_t i = 0; i < kMsgsPerIter; ++i) {
+      msg.t = i;
+      for (auto &r : rings) {
+        while (!r->try_push(msg)) try_yield();
+      }
+    }
+    for (auto &t : workers) t.join();
+  }
+
+  st.SetItemsProcessed(st.iterations() * kMsgsPerIter);
+}
+
+BENCHMARK(BM_FanOut_Broadcast)->DenseRange(1, 4)->UseRealTime();
+BENCHMARK(BM_FanOut_SPSCPerConsumer)->DenseRange(1, 4)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,215 @@
+#include "container/mpmc_queue.hpp"
+#include "container/mpsc_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <boost/lockfree/queue.hpp>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+using sdk::container::MPMCQueue;
+using sdk::container::MPSCQueue;
+
+struct alignas(64) Msg64 {
+  uint64_t t{0};
+  uint8_t payload[56]{};
+};
+
+inline bool try_yield() {
+#ifdef __x86_64__
+  _mm_pause();
+#else
+  std::this_thread::yield();
+#endif
+  return true;
+}
+
+constexpr size_t kQueueCap = 8192;
+constexpr size_t kMsgsPerIter = 1 << 18;
+constexpr size_t kPopBatch = 64;
+
+struct MyMPSCQ {
+  explicit MyMPSCQ(size_t cap) : q_(cap) {}
+  bool try_write(const Msg64 &m) {
+    return q_.try_push(m);
+  }
+  size_t try_read_n(Msg64 *m, size_t n) {
+    return q_.pop_n(m, n);
+  }
+  MPSCQueue<Msg64> q_;
+};
+
+struct MyMPMCQ {
+  explicit MyMPMCQ(size_t cap) : q_(cap) {}
+  bool try_write(const Msg64 &m) {
+    return q_.try_push(m);
+  }
+  size_t try_read_n(Msg64 *m, size_t n) {
+    size_t cnt = 0;
+    while (cnt < n && q_.pop(m[cnt])) ++cnt;
+    return cnt;
+  }
+  MPMCQueue<Msg64> q_;
+};
+
+// What producers do today: a mutex around a deque
+struct MutexQ {
+  explicit MutexQ(size_t cap) : cap_(cap) {}
+  bool try_write(const Msg64 &m) {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (q_.size() >= cap_) return false;
+    q_.push_back(m);
+    return true;
+  }
+  size_t try_read_n(Msg64 *m, size_t n) {
+    std::lock_guard<std::mutex> lk(mu_);
+    const size_t cnt = std::min(n, q_.size());
+    std::copy_n(q_.begin(), cnt, m);
+    q_.erase(q_.begin(), q_.begin() + cnt);
+    return cnt;
+  }
+  size_t cap_;
+  std::mutex mu_;
+  std::deque<Msg64> q_;
+};
+
+// Boost lockfree::queue (MPMC, used here with a single consumer)
+struct BoostMPMCQ {
+  explicit BoostMPMCQ(size_t cap) : q_(cap) {}
+  bool try_write(const Msg64 &m) {
+    return q_.bounded_push(m);
+  }
+  size_t try_read_n(Msg64 *m, size_t n) {
+    size_t cnt = 0;
+    while (cnt < n && q_.pop(m[cnt])) ++cnt;
+    return cnt;
+  }
+  boost::lockfree::queue<Msg64> q_;
+};
+
+// 绑定 CPU
+static void pin_to_cpu_optional(int cpu) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+// range(0): number of producers, one consumer drains with batch pops
+template <class Adapter>
+static void BM_MPSC_Throughput(benchmark::State &st) {
+  const int producers = static_cast<int>(st.range(0));
+  const size_t per_producer = kMsgsPerIter / producers;
+  const size_t total = per_producer * producers;
+  const int ncpu = static_cast<int>(std::thread::hardware_concurrency());
+
+  Adapter A(kQueueCap);
+
+  for (auto _ : st) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> prods;
+    prods.reserve(producers);
+    for (int p = 0; p < producers; ++p) {
+      prods.emplace_back([&, p] {
+        if (ncpu > 0) pin_to_cpu_optional((p + 1) % ncpu);
+        while (!go.load(std::memory_order_acquire)) try_yield();
+        Msg64 msg{};
+        for (size_t i = 0; i < per_producer; ++i) {
+          msg.t = i;
+          while (!A.try_write(msg)) try_yield();
+        }
+      });
+    }
+
+    go.store(true, std::memory_order_release);
+    Msg64 buf[kPopBatch];
+    size_t popped = 0;
+    while (popped < total) {
+      const size_t n = A.try_read_n(buf, kPopBatch);
+      if (n == 0) {
+        try_yield();
+        continue;
+      }
+      popped += n;
+      benchmark::DoNotOptimize(buf[0].t);
+    }
+    for (auto &t : prods) t.join();
+  }
+
+  st.SetItemsProcessed(st.iterations() * total);
+}
+
+// range(0): number of producers and of consumers, a shared task queue
+template <class Adapter>
+static void BM_MPMC_Throughput(benchmark::State &st) {
+  const int threads = static_cast<int>(st.range(0));
+  const size_t per_producer = kMsgsPerIter / threads;
+  const size_t total = per_producer * threads;
+  const int ncpu = static_cast<int>(std::thread::hardware_concurrency());
+
+  Adapter A(kQueueCap);
+
+  for (auto _ : st) {
+    std::atomic<bool> go{false};
+    std::atomic<size_t> popped{0};
+    std::vector<std::thread> workers;
+    workers.reserve(threads * 2);
+    for (int p = 0; p < threads; ++p) {
+      workers.emplace_back([&, p] {
+        if (ncpu > 0) pin_to_cpu_optional((2 * p) % ncpu);
+        while (!go.load(std::memory_order_acquire)) try_yield();
+        Msg64 msg{};
+        for (size_t i = 0; i < per_producer; ++i) {
+          msg.t = i;
+          while (!A.try_write(msg)) try_yield();
+        }
+      });
+      workers.emplace_back([&, p] {
+        if (ncpu > 0) pin_to_cpu_optional((2 * p + 1) % ncpu);
+        while (!go.load(std::memory_order_acquire)) try_yield();
+        Msg64 m{};
+        while (popped.load(std::memory_order_relaxed) < total) {
+          if (A.try_read_n(&m, 1)) {
+            popped.fetch_add(1, std::memory_order_relaxed);
+            benchmark::DoNotOptimize(m.t);
+          } else {
+            try_yield();
+          }
+        }
+      });
+    }
+    go.store(true, std::memory_order_release);
+    for (auto &t : workers) t.join();
+  }
+
+  st.SetItemsProcessed(st.iterations() * total);
+}
+
+// Producers from 1 up to the number of cores
+static void ProducerArgs(benchmark::internal::Benchmark *b) {
+  const int ncpu =
+      std::max(2, static_cast<int>(std::thread::hardware_concurrency()));
+  for (int p = 1; p < ncpu; p *= 2) b->Arg(p);
+  b->Arg(ncpu);
+  b->UseRealTime();
+}
+
+BENCHMARK_TEMPLATE(BM_MPSC_Throughput, MyMPSCQ)->Apply(ProducerArgs);
+BENCHMARK_TEMPLATE(BM_MPSC_Throughput, MyMPMCQ)->Apply(ProducerArgs);
+BENCHMARK_TEMPLATE(BM_MPSC_Throughput, MutexQ)->Apply(ProducerArgs);
+BENCHMARK_TEMPLATE(BM_MPSC_Throughput, BoostMPMCQ)->Apply(ProducerArgs);
+
+BENCHMARK_TEMPLATE(BM_MPMC_Throughput, MyMPMCQ)->Apply(ProducerArgs);
+BENCHMARK_TEMPLATE(BM_MPMC_Throughput, MutexQ)->Apply(ProducerArgs);
+BENCHMARK_TEMPLATE(BM_MPMC_Throughput, BoostMPMCQ)->Apply(ProducerArgs);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,129 @@
+#include "container/shm_ringbuffer.hpp"
+#include "container/wait_strategy.hpp"
+
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using sdk::container::cpu_relax;
+using sdk::container::ShmRole;
+using sdk::container::ShmSPSCRingbuffer;
+
+struct alignas(64) Msg64 {
+  uint64_t t{0};
+  uint8_t payload[56]{};
+};
+
+constexpr uint64_t kStop = ~uint64_t{0};
+constexpr int kMsgsPerIter = 1024;
+
+// 绑定 CPU
+static void pin_to_cpu_optional(int cpu) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+// Producer in this process, consumer in a forked child, no syscalls per
+// message
+static void BM_Shm_TwoProcess(benchmark::State &st) {
+  const size_t cap = static_cast<size_t>(st.range(0));
+  auto ring = ShmSPSCRingbuffer<Msg64>::CreateAnonymous(cap, ShmRole::kProducer);
+  if (!ring) {
+    st.SkipWithError("CreateAnonymous failed");
+    return;
+  }
+
+  const pid_t child = ::fork();
+  if (child == 0) {
+    pin_to_cpu_optional(10);
+    auto cons =
+        ShmSPSCRingbuffer<Msg64>::AttachFd(ring->fd(), ShmRole::kConsumer);
+    if (!cons) ::_exit(1);
+    while (true) {
+      const Msg64 *m = cons->front();
+      if (!m) {
+        if (!cons->peer_alive()) ::_exit(2);
+        cpu_relax();
+        continue;
+      }
+      const bool stop = m->t == kStop;
+      cons->release();
+      if (stop) ::_exit(0);
+    }
+  }
+
+  pin_to_cpu_optional(2);
+  Msg64 msg{};
+  for (auto _ : st) {
+    for (int i = 0; i < kMsgsPerIter; ++i) {
+      msg.t = i;
+      while (!ring->try_push(msg)) cpu_relax();
+    }
+  }
+  msg.t = kStop;
+  while (!ring->try_push(msg)) cpu_relax();
+
+  int status = 0;
+  ::waitpid(child, &status, 0);
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    st.SkipWithError("consumer process failed");
+  }
+  st.SetItemsProcessed(st.iterations() * kMsgsPerIter);
+}
+
+// Same traffic over a pipe, one write/read syscall pair per message
+static void BM_Pipe_TwoProcess(benchmark::State &st) {
+  int fds[2];
+  if (::pipe(fds) != 0) {
+    st.SkipWithError("pipe failed");
+    return;
+  }
+
+  const pid_t child = ::fork();
+  if (child == 0) {
+    pin_to_cpu_optional(10);
+    ::close(fds[1]);
+    Msg64 m{};
+    while (true) {
+      size_t got = 0;
+      while (got < sizeof(m)) {
+        const ssize_t n = ::read(fds[0], reinterpret_cast<char *>(&m) + got,
+                                 sizeof(m) - got);
+        if (n <= 0) ::_exit(2);
+        got += static_cast<size_t>(n);
+      }
+      if (m.t == kStop) ::_exit(0);
+    }
+  }
+
+  ::close(fds[0]);
+  pin_to_cpu_optional(2);
+  Msg64 msg{};
+  for (auto _ : st) {
+    for (int i = 0; i < kMsgsPerIter; ++i) {
+      msg.t = i;
+      if (::write(fds[1], &msg, sizeof(msg)) != sizeof(msg)) {
+        st.SkipWithError("write failed");
+        break;
+      }
+    }
+  }
+  msg.t = kStop;
+  (void)!::write(fds[1], &msg, sizeof(msg));
+  ::close(fds[1]);
+
+  int status = 0;
+  ::waitpid(child, &status, 0);
+  st.SetItemsProcessed(st.iterations() * kMsgsPerIter);
+}
+
+BENCHMARK(BM_Shm_TwoProcess)->Arg(1024)->Arg(8192)->Arg(65536)->UseRealTime();
+BENCHMARK(BM_Pipe_TwoProcess)->UseRealTime();
+
+BENCHMARK_MAIN();
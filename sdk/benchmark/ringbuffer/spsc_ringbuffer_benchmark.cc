@@ -1,9 +1,18 @@
+#include "container/fixed_spsc_ringbuffer.hpp"
+#include "container/mpmc_queue.hpp"
 #include "container/spsc_ringbuffer.hpp"
 
 #include <benchmark/benchmark.h>
+#include <boost/lockfree/queue.hpp>
 #include <boost/lockfree/spsc_queue.hpp>
 #include <vector>
 
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+using sdk::container::FixedSPSCRingbuffer;
+using sdk::container::MPMCQueue;
 using sdk::container::SPSCRingbuffer;
 
 struct alignas(64) Msg64 {
@@ -30,6 +39,78 @@ struct MyQ {
   bool try_read(Msg64 &m) {
     return q_.pop(m);
   }
+  size_t try_write_n(const Msg64 *m, size_t n, int attempts) {
+    size_t done = 0;
+    for (int i = 0; i < attempts && done < n; ++i) {
+      done += q_.try_push_n(m + done, n - done);
+      if (done < n) std::this_thread::yield();
+    }
+    return done;
+  }
+  size_t try_read_n(Msg64 *m, size_t n) {
+    return q_.pop_n(m, n);
+  }
+  Q q_;
+};
+
+// Raw storage, producer writes into the slot and consumer reads from it
+struct MyQInPlace {
+  using Q = SPSCRingbuffer<Msg64, true>;
+  explicit MyQInPlace(size_t cap) : q_(cap) {}
+  bool try_write(const Msg64 &m, int attempts) {
+    for (int i = 0; i < attempts; ++i) {
+      if (Msg64 *slot = q_.reserve()) {
+        ::new (static_cast<void *>(slot)) Msg64;
+        slot->t = m.t;
+        q_.commit();
+        return true;
+      }
+      std::this_thread::yield();
+    }
+    return false;
+  }
+  bool try_read(Msg64 &m) {
+    const Msg64 *slot = q_.front();
+    if (!slot) return false;
+    m.t = slot->t;
+    q_.release();
+    return true;
+  }
+  size_t try_write_n(const Msg64 *m, size_t n, int attempts) {
+    size_t done = 0;
+    while (done < n && try_write(m[done], attempts)) ++done;
+    return done;
+  }
+  size_t try_read_n(Msg64 *m, size_t n) {
+    size_t done = 0;
+    while (done < n && try_read(m[done])) ++done;
+    return done;
+  }
+  Q q_;
+};
+
+// Compile-time power-of-two capacity, runtime cap argument must match Cap
+template <size_t Cap>
+struct MyFixedQ {
+  using Q = FixedSPSCRingbuffer<Msg64, Cap>;
+  explicit MyFixedQ(size_t /*cap*/) {}
+  bool try_write(const Msg64 &m, int attempts) {
+    return q_.push(m, attempts);
+  }
+  bool try_read(Msg64 &m) {
+    return q_.pop(m);
+  }
+  size_t try_write_n(const Msg64 *m, size_t n, int attempts) {
+    size_t done = 0;
+    for (int i = 0; i < attempts && done < n; ++i) {
+      done += q_.try_push_n(m + done, n - done);
+      if (done < n) std::this_thread::yield();
+    }
+    return done;
+  }
+  size_t try_read_n(Msg64 *m, size_t n) {
+    return q_.pop_n(m, n);
+  }
   Q q_;
 };
 
@@ -47,9 +128,68 @@ struct BoostQ {
   bool try_read(Msg64 &m) {
     return q_.pop(m);
   }
+  size_t try_write_n(const Msg64 *m, size_t n, int attempts) {
+    size_t done = 0;
+    for (int i = 0; i < attempts && done < n; ++i) {
+      done += q_.push(m + done, n - done);
+      if (done < n) try_yield();
+    }
+    return done;
+  }
+  size_t try_read_n(Msg64 *m, size_t n) {
+    return q_.pop(m, n);
+  }
   Q q_;
 };
 
+// 3) MPMCQueue used as 1P1C, cost of the CAS on both ends
+struct MyMPMCQ {
+  explicit MyMPMCQ(size_t cap) : q_(cap) {}
+  bool try_write(const Msg64 &m, int attempts) {
+    return q_.push(m, attempts);
+  }
+  bool try_read(Msg64 &m) {
+    return q_.pop(m);
+  }
+  size_t try_write_n(const Msg64 *m, size_t n, int attempts) {
+    size_t done = 0;
+    while (done < n && try_write(m[done], attempts)) ++done;
+    return done;
+  }
+  size_t try_read_n(Msg64 *m, size_t n) {
+    size_t done = 0;
+    while (done < n && try_read(m[done])) ++done;
+    return done;
+  }
+  MPMCQueue<Msg64> q_;
+};
+
+// 4) Boost lockfree::queue (MPMC)
+struct BoostMPMCQ {
+  explicit BoostMPMCQ(size_t cap) : q_(cap) {}
+  bool try_write(const Msg64 &m, int attempts) {
+    for (int i = 0; i < attempts; ++i) {
+      if (q_.bounded_push(m)) return true;
+      try_yield();
+    }
+    return false;
+  }
+  bool try_read(Msg64 &m) {
+    return q_.pop(m);
+  }
+  size_t try_write_n(const Msg64 *m, size_t n, int attempts) {
+    size_t done = 0;
+    while (done < n && try_write(m[done], attempts)) ++done;
+    return done;
+  }
+  size_t try_read_n(Msg64 *m, size_t n) {
+    size_t done = 0;
+    while (done < n && try_read(m[done])) ++done;
+    return done;
+  }
+  boost::lockfree::queue<Msg64> q_;
+};
+
 // 绑定 CPU
 static void pin_to_cpu_optional(int cpu) {
 #ifdef __linux__
@@ -65,6 +205,8 @@ static void BM_SPSC_Throughput(benchmark::State &st) {
   const size_t cap = static_cast<size_t>(st.range(0));
   const int attempts = static_cast<int>(st.range(1));
   const bool with_ts = st.range(2) != 0;
+  // batch == 1 uses the per-element path, otherwise try_write_n/try_read_n
+  const size_t batch = static_cast<size_t>(st.range(3));
 
   Adapter A(cap);
 
@@ -88,11 +230,22 @@ static void BM_SPSC_Throughput(benchmark::State &st) {
 
   std::thread prod([&] {
     pin_to_cpu_optional(2);
+    std::vector<Msg64> out(batch);
     for (auto _ : st) {
       const auto t_end =
           std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
       while (std::chrono::steady_clock::now() < t_end &&
              !stop.load(std::memory_order_relaxed)) {
+        if (batch > 1) {
+          if (with_ts) {
+            const auto t = now_ns();
+            for (auto &m : out) m.t = t;
+          }
+          const size_t n = A.try_write_n(out.data(), batch, attempts);
+          pushed.fetch_add(n, std::memory_order_relaxed);
+          drops.fetch_add(batch - n, std::memory_order_relaxed);
+          continue;
+        }
         Msg64 msg{};
         if (with_ts) msg.t = now_ns();
         if (A.try_write(msg, attempts)) {
@@ -109,24 +262,34 @@ static void BM_SPSC_Throughput(benchmark::State &st) {
   std::thread cons([&] {
     pin_to_cpu_optional(10);
     Msg64 m{};
+    std::vector<Msg64> in(batch);
+    auto consume = [&](const Msg64 &msg) {
+      if (with_ts && msg.t) {
+        uint64_t d = now_ns() - msg.t;
+        hist[bucket(d)].fetch_add(1, std::memory_order_relaxed);
+      }
+    };
+    auto read_once = [&]() -> size_t {
+      if (batch > 1) {
+        const size_t n = A.try_read_n(in.data(), batch);
+        for (size_t i = 0; i < n; ++i) consume(in[i]);
+        return n;
+      }
+      if (!A.try_read(m)) return 0;
+      consume(m);
+      return 1;
+    };
+
     while (!stop.load(std::memory_order_acquire)) {
-      if (A.try_read(m)) {
-        if (with_ts && m.t) {
-          uint64_t d = now_ns() - m.t;
-          hist[bucket(d)].fetch_add(1, std::memory_order_relaxed);
-        }
-        popped.fetch_add(1, std::memory_order_relaxed);
+      if (const size_t n = read_once()) {
+        popped.fetch_add(n, std::memory_order_relaxed);
       } else {
         try_yield();
       }
     }
 
-    while (A.try_read(m)) {
-      if (with_ts && m.t) {
-        uint64_t d = now_ns() - m.t;
-        hist[bucket(d)].fetch_add(1, std::memory_order_relaxed);
-      }
-      popped.fetch_add(1, std::memory_order_relaxed);
+    while (const size_t n = read_once()) {
+      popped.fetch_add(n, std::memory_order_relaxed);
     }
   });
 
@@ -158,16 +321,72 @@ static void BM_SPSC_Throughput(benchmark::State &st) {
   }
 }
 
-BENCHMARK_TEMPLATE(BM_SPSC_Throughput, MyQ)
-    ->Args({1024, 256, 0})
-    ->Args({8192, 256, 0})
-    ->Args({65536, 256, 0})
-    ->Args({8192, 256, 1});
-
-BENCHMARK_TEMPLATE(BM_SPSC_Throughput, BoostQ)
-    ->Args({1024, 256, 0})
-    ->Args({8192, 256, 0})
-    ->Args({65536, 256, 0})
-    ->Args({8192, 256, 1});
+// Single thread push + pop round trip, isolates per-operation index math
+// (modulo in SPSCRingbuffer vs mask in FixedSPSCRingbuffer)
+template <class Adapter>
+static void BM_SPSC_PushPop(benchmark::State &st) {
+  const size_t cap = static_cast<size_t>(st.range(0));
+  Adapter A(cap);
+  Msg64 in{}, out{};
+  for (auto _ : st) {
+    for (int i = 0; i < 64; ++i) {
+      in.t = i;
+      A.try_write(in, 1);
+    }
+    for (int i = 0; i < 64; ++i) {
+      A.try_read(out);
+    }
+    benchmark::DoNotOptimize(out);
+  }
+  st.SetItemsProcessed(st.iterations() * 64);
+}
+
+BENCHMARK_TEMPLATE(BM_SPSC_PushPop, MyQ)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_SPSC_PushPop, MyFixedQ<1024>)->Arg(1024);
+
+// Args: {capacity, attempts, with_ts, batch}
+static void SPSCArgs(benchmark::internal::Benchmark *b) {
+  b->Args({1024, 256, 0, 1})
+      ->Args({8192, 256, 0, 1})
+      ->Args({65536, 256, 0, 1})
+      ->Args({8192, 256, 1, 1})
+      ->Args({8192, 256, 0, 16})
+      ->Args({8192, 256, 0, 64})
+      ->Args({65536, 256, 0, 64})
+      ->Args({8192, 256, 1, 64});
+}
+
+BENCHMARK_TEMPLATE(BM_SPSC_Throughput, MyQ)->Apply(SPSCArgs);
+
+BENCHMARK_TEMPLATE(BM_SPSC_Throughput, MyQInPlace)
+    ->Args({1024, 256, 0, 1})
+    ->Args({8192, 256, 0, 1})
+    ->Args({65536, 256, 0, 1})
+    ->Args({8192, 256, 1, 1});
+
+BENCHMARK_TEMPLATE(BM_SPSC_Throughput, MyFixedQ<1024>)
+    ->Args({1024, 256, 0, 1})
+    ->Args({1024, 256, 0, 64});
+BENCHMARK_TEMPLATE(BM_SPSC_Throughput, MyFixedQ<8192>)
+    ->Args({8192, 256, 0, 1})
+    ->Args({8192, 256, 1, 1})
+    ->Args({8192, 256, 0, 64});
+BENCHMARK_TEMPLATE(BM_SPSC_Throughput, MyFixedQ<65536>)
+    ->Args({65536, 256, 0, 1})
+    ->Args({65536, 256, 0, 64});
+
+BENCHMARK_TEMPLATE(BM_SPSC_Throughput, BoostQ)->Apply(SPSCArgs);
+
+BENCHMARK_TEMPLATE(BM_SPSC_Throughput, MyMPMCQ)
+    ->Args({1024, 256, 0, 1})
+    ->Args({8192, 256, 0, 1})
+    ->Args({65536, 256, 0, 1})
+    ->Args({8192, 256, 1, 1});
+
+BENCHMARK_TEMPLATE(BM_SPSC_Throughput, BoostMPMCQ)
+    ->Args({1024, 256, 0, 1})
+    ->Args({8192, 256, 0, 1})
+    ->Args({65536, 256, 0, 1})
+    ->Args({8192, 256, 1, 1});
 
 BENCHMARK_MAIN();
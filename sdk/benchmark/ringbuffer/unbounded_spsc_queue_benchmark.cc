@@ -0,0 +1,143 @@
+#include "container/spsc_ringbuffer.hpp"
+#include "container/unbounded_spsc_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <thread>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+using sdk::container::SPSCRingbuffer;
+using sdk::container::UnboundedSPSCQueue;
+
+struct alignas(64) Msg64 {
+  uint64_t t{0};
+  uint8_t payload[56]{};
+};
+
+inline bool try_yield() {
+#ifdef __x86_64__
+  _mm_pause();
+#else
+  std::this_thread::yield();
+#endif
+  return true;
+}
+
+constexpr size_t kBoundedCap = 8192;
+constexpr int kBurstsPerIter = 16;
+
+// 绑定 CPU
+static void pin_to_cpu_optional(int cpu) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+// range(0): burst size. The producer writes a whole burst back to back, then
+// waits for the consumer to drain it before the next one.
+static void BM_Burst_Unbounded(benchmark::State &st) {
+  const size_t burst = static_cast<size_t>(st.range(0));
+  const int ncpu = static_cast<int>(std::thread::hardware_concurrency());
+  UnboundedSPSCQueue<Msg64> q;
+  size_t peak_bytes = 0;
+  size_t growth_after_warmup = 0;
+  size_t warm_bytes = 0;
+
+  for (auto _ : st) {
+    std::atomic<bool> stop{false};
+    std::thread consumer([&] {
+      if (ncpu > 0) pin_to_cpu_optional(1 % ncpu);
+      Msg64 buf[64];
+      while (true) {
+        if (q.pop_n(buf, 64) != 0) {
+          benchmark::DoNotOptimize(buf[0].t);
+        } else if (stop.load(std::memory_order_acquire) && q.empty()) {
+          break;
+        } else {
+          try_yield();
+        }
+      }
+    });
+
+    Msg64 msg{};
+    for (int b = 0; b < kBurstsPerIter; ++b) {
+      for (size_t i = 0; i < burst; ++i) {
+        msg.t = i;
+        q.try_push(msg);
+      }
+      peak_bytes = std::max(peak_bytes, q.memory_usage());
+      while (!q.empty()) try_yield();
+    }
+    stop.store(true, std::memory_order_release);
+    consumer.join();
+
+    // Bytes allocated after the first iteration reached the high-water mark
+    if (warm_bytes == 0) warm_bytes = q.memory_usage();
+    growth_after_warmup = q.memory_usage() - warm_bytes;
+  }
+
+  st.SetItemsProcessed(st.iterations() * kBurstsPerIter * burst);
+  st.counters["peak_bytes"] = static_cast<double>(peak_bytes);
+  st.counters["steady_growth_bytes"] =
+      static_cast<double>(growth_after_warmup);
+  q.trim();
+  st.counters["trimmed_bytes"] = static_cast<double>(q.memory_usage());
+}
+
+// Same bursts on a bounded ring: the producer spins whenever it is full
+static void BM_Burst_Bounded(benchmark::State &st) {
+  const size_t burst = static_cast<size_t>(st.range(0));
+  const int ncpu = static_cast<int>(std::thread::hardware_concurrency());
+  SPSCRingbuffer<Msg64> q(kBoundedCap);
+  size_t full_spins = 0;
+
+  for (auto _ : st) {
+    std::atomic<bool> stop{false};
+    std::thread consumer([&] {
+      if (ncpu > 0) pin_to_cpu_optional(1 % ncpu);
+      Msg64 buf[64];
+      while (true) {
+        if (q.pop_n(buf, 64) != 0) {
+          benchmark::DoNotOptimize(buf[0].t);
+        } else if (stop.load(std::memory_order_acquire) && q.empty()) {
+          break;
+        } else {
+          try_yield();
+        }
+      }
+    });
+
+    Msg64 msg{};
+    for (int b = 0; b < kBurstsPerIter; ++b) {
+      for (size_t i = 0; i < burst; ++i) {
+        msg.t = i;
+        while (!q.try_push(msg)) {
+          ++full_spins;
+          try_yield();
+        }
+      }
+      while (!q.empty()) try_yield();
+    }
+    stop.store(true, std::memory_order_release);
+    consumer.join();
+  }
+
+  st.SetItemsProcessed(st.iterations() * kBurstsPerIter * burst);
+  st.counters["bytes"] = static_cast<double>(kBoundedCap * sizeof(Msg64));
+  st.counters["full_spins"] = benchmark::Counter(
+      static_cast<double>(full_spins), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_Burst_Unbounded)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)
+    ->UseRealTime();
+BENCHMARK(BM_Burst_Bounded)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -1,9 +1,21 @@
+#include "container/concurrent_segment_tree.h"
+#include "container/fenwick_tree.h"
+#include "container/iterative_segment_tree.h"
+#include "container/prefix_sum_array.h"
 #include "container/segment_tree.h"
+#include "container/sparse_table.h"
+#include "executor/thread_pool.h"
 
 #include <algorithm>
 #include <benchmark/benchmark.h>
 #include <glog/logging.h>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <random>
+#include <string>
+#include <type_traits>
+#include <unistd.h>
 #include <vector>
 
 static const int N = 100000;
@@ -11,7 +23,15 @@ static const int Q = 10000;
 static std::vector<int> arr;
 static std::vector<std::pair<int, int>> queries;
 
+using sdk::container::BlockSparseTable;
+using sdk::container::ConcurrentSegmentTree;
+using sdk::container::FenwickTree;
+using sdk::container::IterativeSegmentTree;
+using sdk::container::MinOp;
+using sdk::container::PrefixSumArray;
+using sdk::container::RangeFenwickTree;
 using sdk::container::SegmentTree;
+using sdk::container::SparseTable;
 
 static void PrepareData() {
   std::mt19937 rng(std::random_device{}());
@@ -28,6 +48,32 @@ static void PrepareData() {
   }
 }
 
+// Array and Q random ranges of size n, built once per n
+struct Dataset {
+  std::vector<int> data;
+  std::vector<std::pair<int, int>> ranges;
+};
+
+static const Dataset &GetDataset(int n) {
+  static std::map<int, Dataset> cache;
+  auto it = cache.find(n);
+  if (it != cache.end()) return it->second;
+
+  Dataset &ds = cache[n];
+  std::mt19937 rng(n);
+  std::uniform_int_distribution<int> dist(1, 100);
+  ds.data.resize(n);
+  for (auto &v : ds.data) v = dist(rng);
+  std::uniform_int_distribution<int> distIndex(0, n - 1);
+  ds.ranges.resize(Q);
+  for (auto &q : ds.ranges) {
+    int l = distIndex(rng), r = distIndex(rng);
+    if (l > r) std::swap(l, r);
+    q = {l, r};
+  }
+  return ds;
+}
+
 // Benchmark 1: std::accumulate
 static void BM_Accumulate(benchmark::State &state) {
   for (auto _ : state) {
@@ -53,6 +99,272 @@ static void BM_SegmentTree(benchmark::State &state) {
 }
 BENCHMARK(BM_SegmentTree);
 
+// Bytes held by each structure for n elements, reported as a counter
+template <class Tree>
+static double Footprint(const Tree &st, int64_t) {
+  return static_cast<double>(st.memory_usage());
+}
+
+template <>
+double Footprint(const SegmentTree<> &, int64_t n) {
+  return 4.0 * n * (sizeof(sdk::container::RangeStats<int64_t>) +
+                    sizeof(int64_t));
+}
+
+template <>
+double Footprint(const SegmentTree<int64_t, MinOp<int64_t>> &, int64_t n) {
+  return 4.0 * n * 2 * sizeof(int64_t);
+}
+
+template <>
+double Footprint(const IterativeSegmentTree &, int64_t n) {
+  return 2.0 * n * 32;
+}
+
+template <>
+double Footprint(const FenwickTree<> &, int64_t n) {
+  return (n + 1.0) * sizeof(int64_t);
+}
+
+template <>
+double Footprint(const RangeFenwickTree<> &, int64_t n) {
+  return 2.0 * (n + 1) * sizeof(int64_t);
+}
+
+// Benchmark 3: trees by N, Q queries per iteration. range(0) = N.
+// The recursive tree holds 4N StatsOp nodes plus lazies (~32 bytes * 4N),
+// so it stops at 1e7; the bottom-up one holds 2N 32-byte nodes and goes to
+// 1e8 (~6.4 GB). The Fenwick trees hold N (point add) or 2N (range add)
+// int64_t and answer sums only; PrefixSumArray holds N + 1 int64_t and is
+// read-only.
+template <class Tree>
+static void BM_Query(benchmark::State &state) {
+  const Dataset &ds = GetDataset(static_cast<int>(state.range(0)));
+  Tree st(ds.data);
+  state.counters["footprint_bytes"] = Footprint(st, state.range(0));
+  for (auto _ : state) {
+    long long sum = 0;
+    for (auto [l, r] : ds.ranges) {
+      sum += st.query(l, r);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * Q);
+}
+
+// Q range adds per iteration, alternating sign so values stay bounded
+template <class Tree>
+static void BM_Update(benchmark::State &state) {
+  const Dataset &ds = GetDataset(static_cast<int>(state.range(0)));
+  Tree st(ds.data);
+  int diff = 1;
+  for (auto _ : state) {
+    for (auto [l, r] : ds.ranges) {
+      st.update_range(diff, l, r);
+    }
+    diff = -diff;
+  }
+  benchmark::DoNotOptimize(st.query(0, 0));
+  state.SetItemsProcessed(state.iterations() * Q);
+}
+
+// The same Q queries answered by one query_batch() call
+static void BM_QueryBatch(benchmark::State &state) {
+  const Dataset &ds = GetDataset(static_cast<int>(state.range(0)));
+  SegmentTree st(ds.data);
+  std::vector<int64_t> out(ds.ranges.size());
+  for (auto _ : state) {
+    st.query_batch(ds.ranges, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * Q);
+}
+
+// 16 * Q queries per batch split over range(1) pool threads
+static void BM_QueryBatchParallel(benchmark::State &state) {
+  const Dataset &ds = GetDataset(static_cast<int>(state.range(0)));
+  SegmentTree st(ds.data);
+  std::vector<std::pair<int, int>> ranges;
+  for (int i = 0; i < 16; ++i) {
+    ranges.insert(ranges.end(), ds.ranges.begin(), ds.ranges.end());
+  }
+  std::vector<int64_t> out(ranges.size());
+  sdk::executor::ThreadPool pool(static_cast<size_t>(state.range(1)));
+  for (auto _ : state) {
+    st.query_batch(ranges, out, pool);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * ranges.size());
+}
+
+// Q range minimums per iteration on read-only data: the recursive tree
+// against the sparse tables
+template <class Tree>
+static void BM_RangeMin(benchmark::State &state) {
+  const Dataset &ds = GetDataset(static_cast<int>(state.range(0)));
+  Tree st(ds.data);
+  state.counters["footprint_bytes"] = Footprint(st, state.range(0));
+  for (auto _ : state) {
+    int64_t acc = 0;
+    for (auto [l, r] : ds.ranges) {
+      acc ^= st.query(l, r);
+    }
+    benchmark::DoNotOptimize(acc);
+  }
+  state.SetItemsProcessed(state.iterations() * Q);
+}
+
+// Construction cost, the prefix scan is vectorized in the simd build
+template <class Tree>
+static void BM_Build(benchmark::State &state) {
+  const Dataset &ds = GetDataset(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    Tree st(ds.data);
+    benchmark::DoNotOptimize(st.query(0, 0));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Startup from a snapshot saved by SegmentTree::save(), against
+// BM_Build<SegmentTree<>>: open_mmap() plus one query, which faults in
+// only the pages on its path
+static void BM_OpenMmap(benchmark::State &state) {
+  const Dataset &ds = GetDataset(static_cast<int>(state.range(0)));
+  const std::string path = "/tmp/segment_tree_benchmark." +
+                           std::to_string(state.range(0)) + ".snapshot";
+  if (!SegmentTree(ds.data).save(path)) {
+    state.SkipWithError("save failed");
+    return;
+  }
+  for (auto _ : state) {
+    auto st = SegmentTree<>::open_mmap(path);
+    benchmark::DoNotOptimize(st->query(0, state.range(0) / 2));
+  }
+  ::unlink(path.c_str());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// SegmentTree behind one mutex, how it is shared today
+class LockedSegmentTree {
+ public:
+  explicit LockedSegmentTree(const std::vector<int> &data) : tree_(data) {}
+
+  int64_t query(int64_t l, int64_t r) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tree_.query(l, r);
+  }
+
+  void update_range(int64_t diff, int64_t l, int64_t r) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tree_.update_range(diff, l, r);
+  }
+
+ private:
+  std::mutex mutex_;
+  SegmentTree<> tree_;
+};
+
+// Thread 0 applies range adds non-stop while the other threads query the
+// same tree of 1e5 elements; reads and writes are reported per second
+template <class Shared>
+static void BM_ReadersWithWriter(benchmark::State &state) {
+  const Dataset &ds = GetDataset(100000);
+  // Replaced by the next run, the loop start is a barrier for all threads
+  static std::unique_ptr<Shared> shared;
+  if (state.thread_index() == 0) shared = std::make_unique<Shared>(ds.data);
+  size_t i = state.thread_index() * 997;
+  int diff = 1;
+  for (auto _ : state) {
+    auto [l, r] = ds.ranges[i++ % Q];
+    if (state.thread_index() == 0) {
+      shared->update_range(diff, l, r);
+      diff = -diff;
+    } else {
+      benchmark::DoNotOptimize(shared->query(l, r));
+    }
+  }
+  const char *name = state.thread_index() == 0 ? "writes" : "reads";
+  state.counters[name] = benchmark::Counter(
+      static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+
+// Q single element adds per iteration, set() on the recursive tree
+template <class Tree>
+static void BM_PointAdd(benchmark::State &state) {
+  const Dataset &ds = GetDataset(static_cast<int>(state.range(0)));
+  Tree st(ds.data);
+  std::vector<int64_t> values(ds.data.begin(), ds.data.end());
+  int diff = 1;
+  for (auto _ : state) {
+    for (auto [l, r] : ds.ranges) {
+      if constexpr (std::is_same_v<Tree, FenwickTree<>>) {
+        st.add(l, diff);
+      } else {
+        values[l] += diff;
+        st.set(l, values[l]);
+      }
+    }
+    diff = -diff;
+  }
+  benchmark::DoNotOptimize(st.query(0, 0));
+  state.SetItemsProcessed(state.iterations() * Q);
+}
+
+BENCHMARK(BM_Query<SegmentTree<>>)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK(BM_QueryBatch)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK(BM_QueryBatchParallel)
+    ->ArgsProduct({{100000, 10000000}, {1, 2, 4, 8}})
+    ->UseRealTime();
+BENCHMARK(BM_Query<IterativeSegmentTree>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK(BM_Query<FenwickTree<>>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK(BM_Query<RangeFenwickTree<>>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK(BM_Query<PrefixSumArray<>>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK(BM_RangeMin<SegmentTree<int64_t, MinOp<int64_t>>>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000);
+BENCHMARK(BM_RangeMin<SparseTable<>>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000);
+BENCHMARK(BM_RangeMin<BlockSparseTable<>>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK(BM_Build<SegmentTree<>>)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK(BM_OpenMmap)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK(BM_Build<PrefixSumArray<>>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000);
+BENCHMARK(BM_Build<SparseTable<>>)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK(BM_Build<BlockSparseTable<>>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000);
+BENCHMARK(BM_Update<SegmentTree<>>)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK(BM_Update<IterativeSegmentTree>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK(BM_Update<RangeFenwickTree<>>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK(BM_ReadersWithWriter<LockedSegmentTree>)
+    ->ThreadRange(2, 8)
+    ->UseRealTime();
+BENCHMARK(BM_ReadersWithWriter<ConcurrentSegmentTree<>>)
+    ->ThreadRange(2, 8)
+    ->UseRealTime();
+BENCHMARK(BM_PointAdd<SegmentTree<>>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000);
+BENCHMARK(BM_PointAdd<FenwickTree<>>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+
 int main(int argc, char **argv) {
   PrepareData();
   ::benchmark::Initialize(&argc, argv);
@@ -0,0 +1,211 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file bip_buffer.hpp
+ * @brief A variable-length SPSC byte ring (bip buffer) for framed messages.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "macro/macros.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <atomic>
+#include <new>
+
+namespace sdk {
+namespace container {
+
+// Thread-safe SPSC ring of variable-length records.
+//
+// Every record is an 8-byte header (payload length) followed by the payload,
+// padded to 8 bytes, and is always contiguous in memory. When a record does
+// not fit before the end of the storage the producer leaves a wrap marker and
+// places it at offset 0, like the second region of a bip buffer.
+//
+// Producer:
+//   uint8_t *p = ring.reserve(max_len);  // contiguous, nullptr when full
+//   ... write up to max_len bytes into p ...
+//   ring.commit(actual_len);             // actual_len <= max_len
+// Consumer:
+//   size_t len;
+//   const uint8_t *p = ring.front(&len); // nullptr when empty
+//   ... read len bytes ...
+//   ring.release();
+//
+// A record needs header + payload bytes in one contiguous free region, so
+// payloads up to capacity() / 2 - kHeaderSize always fit an empty ring.
+class BipBuffer {
+ public:
+  static constexpr size_t kHeaderSize = 8;
+
+  explicit BipBuffer(size_t capacity)
+      : cap_(align(capacity < 2 * kHeaderSize ? 2 * kHeaderSize : capacity)),
+        data_(static_cast<uint8_t *>(
+            ::operator new(cap_, std::align_val_t{kHeaderSize}))),
+        write_(0), read_cache_(0), res_off_(0), res_len_(0), read_(0),
+        write_cache_(0) {}
+
+  ~BipBuffer() {
+    ::operator delete(data_, std::align_val_t{kHeaderSize});
+  }
+
+  DISALLOW_COPY_AND_MOVE(BipBuffer);
+
+  /*
+   * @brief Reserve a contiguous region for a payload of up to len bytes
+   * @param size_t len
+   * @return uint8_t*, nullptr when there is no contiguous room
+   */
+  uint8_t *reserve(size_t len) noexcept {
+    // Never fits, and record_size() would wrap for len near SIZE_MAX
+    if (len > cap_ - kHeaderSize) return nullptr;
+    const size_t need = record_size(len);
+    const size_t w = write_.load(std::memory_order_relaxed);
+    size_t off = place(w, need, read_cache_);
+    if (off == kNoRoom) {
+      read_cache_ = read_.load(std::memory_order_acquire);
+      off = place(w, need, read_cache_);
+      if (off == kNoRoom) {
+        return nullptr;
+      }
+    }
+    res_off_ = off;
+    res_len_ = len;
+    return data_ + off + kHeaderSize;
+  }
+
+  /*
+   * @brief Publish the last reservation with its actual payload length
+   * @param size_t len, must not exceed the reserved length
+   */
+  void commit(size_t len) noexcept {
+    if (len > res_len_) len = res_len_;
+    const size_t w = write_.load(std::memory_order_relaxed);
+    if (res_off_ != w) {
+      // Placed at the start: tell the consumer to skip the tail
+      store_header(w, kWrapMarker);
+    }
+    store_header(res_off_, len);
+    const size_t next = res_off_ + record_size(len);
+    write_.store(next == cap_ ? 0 : next, std::memory_order_release);
+  }
+
+  /*
+   * @brief Copy a payload into the ring
+   * @return bool, false when there is no contiguous room
+   */
+  bool try_write(const uint8_t *data, size_t len) noexcept {
+    uint8_t *p = reserve(len);
+    if (!p) {
+      return false;
+    }
+    if (len != 0) {
+      std::memcpy(p, data, len);
+    }
+    commit(len);
+    return true;
+  }
+
+  /*
+   * @brief Get the oldest record
+   * @param size_t *len, set to the payload length
+   * @return const uint8_t*, nullptr when empty
+   */
+  const uint8_t *front(size_t *len) noexcept {
+    const size_t r = record_start();
+    if (r == kNoRoom) {
+      return nullptr;
+    }
+    *len = load_header(r);
+    return data_ + r + kHeaderSize;
+  }
+
+  /*
+   * @brief Drop the record returned by the last successful front()
+   */
+  void release() noexcept {
+    const size_t r = record_start();
+    const size_t next = r + record_size(load_header(r));
+    read_.store(next == cap_ ? 0 : next, std::memory_order_release);
+  }
+
+  bool empty() const noexcept {
+    return read_.load(std::memory_order_acquire) ==
+           write_.load(std::memory_order_acquire);
+  }
+
+  size_t capacity() const noexcept {
+    return cap_;
+  }
+
+ private:
+  static constexpr size_t kNoRoom = ~size_t{0};
+  static constexpr uint64_t kWrapMarker = ~uint64_t{0};
+
+  static constexpr size_t align(size_t n) noexcept {
+    return (n + kHeaderSize - 1) & ~(kHeaderSize - 1);
+  }
+
+  static constexpr size_t record_size(size_t len) noexcept {
+    return kHeaderSize + align(len);
+  }
+
+  // Where a record of need bytes goes given a view of read_, w == r is empty
+  // so the producer never advances write_ onto read_.
+  size_t place(size_t w, size_t need, size_t r) const noexcept {
+    if (w >= r) {
+      const size_t tail = cap_ - w;
+      if (need < tail || (need == tail && r != 0)) {
+        return w;
+      }
+      return need < r ? 0 : kNoRoom;
+    }
+    return need < r - w ? w : kNoRoom;
+  }
+
+  // Consumer: offset of the oldest record, following a wrap marker
+  size_t record_start() noexcept {
+    size_t r = read_.load(std::memory_order_relaxed);
+    if (r == write_cache_) {
+      write_cache_ = write_.load(std::memory_order_acquire);
+      if (r == write_cache_) {
+        return kNoRoom;
+      }
+    }
+    if (load_header(r) == kWrapMarker) {
+      r = 0;
+    }
+    return r;
+  }
+
+  void store_header(size_t off, uint64_t v) noexcept {
+    std::memcpy(data_ + off, &v, sizeof(v));
+  }
+
+  uint64_t load_header(size_t off) const noexcept {
+    uint64_t v;
+    std::memcpy(&v, data_ + off, sizeof(v));
+    return v;
+  }
+
+  const size_t cap_;
+  uint8_t *const data_;
+  // Producer side
+  alignas(64) std::atomic<size_t> write_;
+  size_t read_cache_;
+  size_t res_off_;
+  size_t res_len_;
+  // Consumer side
+  alignas(64) std::atomic<size_t> read_;
+  size_t write_cache_;
+};
+
+} // namespace container
+} // namespace sdk
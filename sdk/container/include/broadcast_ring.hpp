@@ -0,0 +1,350 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file broadcast_ring.hpp
+ * @brief A single-producer multi-consumer broadcast ring (disruptor style).
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "container/wait_strategy.hpp"
+#include "macro/macros.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sdk {
+namespace container {
+
+// Single producer fanning out one event stream to several consumers without
+// copying it per consumer. Every consumer sees every event.
+//
+// The producer publishes a free-running cursor; each consumer owns its own
+// sequence (number of events it has released). A consumer may read up to
+// its barrier: the cursor, or the slowest of the consumers it depends on.
+// The producer only overwrites a slot once every consumer has released it,
+// so it gates on the slowest consumer at the end of each dependency chain.
+//
+//   BroadcastRing<Event> ring(1024);
+//   auto *journal = ring.add_consumer();
+//   auto *risk = ring.add_consumer();
+//   auto *persist = ring.add_consumer({journal, risk}); // after both
+//
+// Consumers must be added before the producer starts. Each Consumer is
+// driven by exactly one thread. T must be default-constructible and
+// copy/move-assignable; slots are reused, not destroyed, on release.
+template <typename T, typename Wait = SpinYieldWait<>>
+class BroadcastRing {
+ public:
+  class Consumer {
+   public:
+    DISALLOW_COPY_AND_MOVE(Consumer);
+
+    /*
+     * @brief Get the oldest unread event, drop it with release()
+     * @return const T*, nullptr when nothing is available past the barrier
+     */
+    const T *front() noexcept {
+      const uint64_t seq = seq_.load(std::memory_order_relaxed);
+      if (seq == avail_cache_) {
+        avail_cache_ = barrier();
+        if (seq == avail_cache_) {
+          return nullptr;
+        }
+      }
+      return ring_->slot(seq);
+    }
+
+    void release() noexcept {
+      publish(seq_.load(std::memory_order_relaxed) + 1);
+    }
+
+    bool pop(T &value) noexcept(std::is_nothrow_copy_assignable_v<T>) {
+      const T *t = front();
+      if (!t) {
+        return false;
+      }
+      value = *t;
+      release();
+      return true;
+    }
+
+    /*
+     * @brief Hand every available event (up to max) to fn(const T &) and
+     *        release them with a single publish of the sequence
+     * @return size_t, number of events consumed
+     */
+    template <typename Fn>
+    size_t consume(Fn &&fn, size_t max = SIZE_MAX) {
+      const uint64_t seq = seq_.load(std::memory_order_relaxed);
+      if (avail_cache_ - seq < max) {
+        avail_cache_ = barrier();
+      }
+      const size_t cnt = std::min<size_t>(max, avail_cache_ - seq);
+      for (size_t i = 0; i < cnt; ++i) {
+        fn(*ring_->slot(seq + i));
+      }
+      if (cnt != 0) {
+        publish(seq + cnt);
+      }
+      return cnt;
+    }
+
+    /*
+     * @brief Pop, blocking with the Wait strategy while nothing is available
+     * @return bool, false when still empty after timeout
+     */
+    template <class Rep, class Period>
+    bool pop_wait(T &value, std::chrono::duration<Rep, Period> timeout) {
+      if (pop(value)) {
+        return true;
+      }
+      const auto deadline = deadline_after(timeout);
+      while (ring_->advanced_.wait_until([this] { return available() != 0; },
+                                         deadline)) {
+        if (pop(value)) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // Events published past this consumer's barrier and not yet released
+    size_t available() const noexcept {
+      return static_cast<size_t>(barrier() -
+                                 seq_.load(std::memory_order_relaxed));
+    }
+
+    // Number of events this consumer has released
+    uint64_t sequence() const noexcept {
+      return seq_.load(std::memory_order_acquire);
+    }
+
+   private:
+    friend class BroadcastRing;
+
+    Consumer(BroadcastRing *ring, std::vector<const Consumer *> deps,
+             uint64_t start)
+        : ring_(ring), deps_(std::move(deps)), seq_(start),
+          avail_cache_(start) {}
+
+    uint64_t barrier() const noexcept {
+      if (deps_.empty()) {
+        return ring_->cursor_.load(std::memory_order_acquire);
+      }
+      uint64_t min = UINT64_MAX;
+      for (const Consumer *dep : deps_) {
+        min = std::min(min, dep->seq_.load(std::memory_order_acquire));
+      }
+      return min;
+    }
+
+    void publish(uint64_t seq) noexcept {
+      seq_.store(seq, std::memory_order_release);
+      // Wakes the producer and any consumer depending on this one
+      ring_->not_full_.notify();
+      ring_->advanced_.notify();
+    }
+
+    BroadcastRing *const ring_;
+    const std::vector<const Consumer *> deps_;
+    // Written only by the owning thread, read by the producer and dependents
+    alignas(64) std::atomic<uint64_t> seq_;
+    uint64_t avail_cache_;
+  };
+
+  explicit BroadcastRing(size_t size)
+      : capacity_(round_up(size)), mask_(capacity_ - 1),
+        data_(new T[capacity_]), cursor_(0), gate_cache_(0) {}
+
+  ~BroadcastRing() {
+    delete[] data_;
+  }
+
+  DISALLOW_COPY_AND_MOVE(BroadcastRing);
+
+  /*
+   * @brief Register a consumer that sees an event only after all of after
+   *        have released it; with no dependency it follows the producer.
+   *        Not thread-safe, call before the producer starts.
+   * @param std::initializer_list<const Consumer *> after, consumers of this
+   *        ring
+   * @return Consumer*, owned by the ring
+   */
+  Consumer *add_consumer(std::initializer_list<const Consumer *> after = {}) {
+    std::vector<const Consumer *> deps(after);
+    const uint64_t start = cursor_.load(std::memory_order_relaxed);
+    consumers_.emplace_back(new Consumer(this, std::move(deps), start));
+    Consumer *c = consumers_.back().get();
+
+    // Only the ends of the dependency chains gate the producer, upstream
+    // consumers are always at least as far ahead
+    gating_.erase(std::remove_if(gating_.begin(), gating_.end(),
+                                 [&](const Consumer *g) {
+                                   return std::find(after.begin(), after.end(),
+                                                    g) != after.end();
+                                 }),
+                  gating_.end());
+    gating_.push_back(c);
+    gate_cache_ = start;
+    return c;
+  }
+
+  bool try_push(const T &value) noexcept(
+      std::is_nothrow_copy_assignable_v<T>) {
+    T *slot = reserve();
+    if (!slot) {
+      return false;
+    }
+    *slot = value;
+    commit();
+    return true;
+  }
+
+  bool try_push(T &&value) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    T *slot = reserve();
+    if (!slot) {
+      return false;
+    }
+    *slot = std::move(value);
+    commit();
+    return true;
+  }
+
+  bool push(const T &value, int max_attempt) noexcept(
+      std::is_nothrow_copy_assignable_v<T>) {
+    for (auto i = 0; i < max_attempt; ++i) {
+      if (try_push(value)) {
+        return true;
+      }
+      std::this_thread::yield();
+    }
+    return false;
+  }
+
+  /*
+   * @brief Push, blocking with the Wait strategy while the slowest consumer
+   *        is a full lap behind
+   * @return bool, false when still full after timeout
+   */
+  template <class Rep, class Period>
+  bool push_wait(const T &value, std::chrono::duration<Rep, Period> timeout) {
+    if (try_push(value)) {
+      return true;
+    }
+    const auto deadline = deadline_after(timeout);
+    while (not_full_.wait_until([this] { return !full(); }, deadline)) {
+      if (try_push(value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /*
+   * @brief Get the next slot to overwrite in place, publish with commit()
+   * @return T*, nullptr when the slowest consumer has not released it yet
+   */
+  T *reserve() noexcept {
+    const uint64_t cursor = cursor_.load(std::memory_order_relaxed);
+    if (cursor - gate_cache_ == capacity_) {
+      gate_cache_ = gate();
+      if (cursor - gate_cache_ == capacity_) {
+        return nullptr;
+      }
+    }
+    return slot(cursor);
+  }
+
+  void commit() noexcept {
+    cursor_.store(cursor_.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_release);
+    advanced_.notify();
+  }
+
+  /*
+   * @brief Publish up to n events from [first, first + n) with a single
+   *        store of the cursor
+   * @return size_t, number of events published
+   */
+  template <typename InputIt>
+  size_t try_push_n(InputIt first, size_t n) noexcept(
+      std::is_nothrow_assignable_v<T &, decltype(*first)>) {
+    const uint64_t cursor = cursor_.load(std::memory_order_relaxed);
+    if (capacity_ - (cursor - gate_cache_) < n) {
+      gate_cache_ = gate();
+    }
+    const size_t cnt = std::min<size_t>(n, capacity_ - (cursor - gate_cache_));
+    for (size_t i = 0; i < cnt; ++i, ++first) {
+      *slot(cursor + i) = *first;
+    }
+    if (cnt != 0) {
+      cursor_.store(cursor + cnt, std::memory_order_release);
+      advanced_.notify();
+    }
+    return cnt;
+  }
+
+  // Producer view: true when the slowest consumer is a full lap behind
+  bool full() const noexcept {
+    return cursor_.load(std::memory_order_acquire) - gate() == capacity_;
+  }
+
+  // Number of events published so far
+  uint64_t cursor() const noexcept {
+    return cursor_.load(std::memory_order_acquire);
+  }
+
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+ private:
+  static size_t round_up(size_t n) noexcept {
+    size_t cap = 2;
+    while (cap < n) cap <<= 1;
+    return cap;
+  }
+
+  T *slot(uint64_t seq) const noexcept {
+    return data_ + (seq & mask_);
+  }
+
+  // Slowest gating consumer, the cursor itself when there is none
+  uint64_t gate() const noexcept {
+    uint64_t min = cursor_.load(std::memory_order_relaxed);
+    for (const Consumer *c : gating_) {
+      min = std::min(min, c->seq_.load(std::memory_order_acquire));
+    }
+    return min;
+  }
+
+  const size_t capacity_;
+  const uint64_t mask_;
+  T *const data_;
+  std::vector<std::unique_ptr<Consumer>> consumers_;
+  std::vector<const Consumer *> gating_;
+  // Producer side: cursor_ is published, gate_cache_ is a private copy of
+  // the slowest gating sequence
+  alignas(64) std::atomic<uint64_t> cursor_;
+  uint64_t gate_cache_;
+  // Consumers wait on advanced_, the producer waits on not_full_
+  alignas(64) Wait advanced_;
+  Wait not_full_;
+};
+
+} // namespace container
+} // namespace sdk
@@ -0,0 +1,183 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file concurrent_segment_tree.h
+ * @brief A segment tree readable from many threads while one thread writes.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "container/segment_tree.h"
+#include "container/wait_strategy.hpp"
+#include "macro/macros.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace sdk {
+namespace container {
+
+// SegmentTree for one writer and any number of readers, readers never block
+//
+// Left-right scheme over two copies of the tree: readers always use the
+// copy selected by side_, the writer updates the other copy, flips side_,
+// waits until the readers that may still be on the old copy have left, then
+// replays the update there. A reader therefore sees one consistent version
+// for the whole read() call and costs two atomic increments on a per-thread
+// counter slot; the writer pays every update twice plus the wait for
+// in-flight reads. Memory is two trees.
+//
+//   ConcurrentSegmentTree<> st(data);
+//   // writer thread
+//   st.update_range(5, 10, 20);
+//   // reader threads
+//   auto sum = st.query(0, 99);
+//   st.read([](const auto &tree) { ... several queries, one snapshot ... });
+//
+// Writers are serialized by a mutex, so several writers are safe but do not
+// scale.
+template <typename T = int64_t, typename Op = StatsOp<T>,
+          typename LazyOp = RangeAdd<Op>>
+class ConcurrentSegmentTree {
+ public:
+  using Tree = SegmentTree<T, Op, LazyOp>;
+  using value_type = typename Tree::value_type;
+  using result_type = typename Tree::result_type;
+  using tag_type = typename LazyOp::tag_type;
+
+  template <typename U>
+  explicit ConcurrentSegmentTree(const std::vector<U> &data)
+      : trees_{Tree(data), Tree(data)} {}
+
+  DISALLOW_COPY_AND_MOVE(ConcurrentSegmentTree);
+
+  /*
+   * @brief Run fn(const Tree &) on a consistent snapshot, from any thread.
+   *        Updates published while fn runs are not visible to it.
+   * @return whatever fn returns
+   */
+  template <typename Fn>
+  decltype(auto) read(Fn &&fn) const {
+    Guard guard(*this);
+    return std::forward<Fn>(fn)(trees_[guard.side]);
+  }
+
+  result_type query(int64_t l, int64_t r) const {
+    return read([&](const Tree &tree) { return tree.query(l, r); });
+  }
+
+  value_type aggregate(int64_t l, int64_t r) const {
+    return read([&](const Tree &tree) { return tree.aggregate(l, r); });
+  }
+
+  /*
+   * @brief Apply diff to every element of [l, r] and publish it
+   */
+  void update_range(tag_type diff, int64_t l, int64_t r) {
+    write([&](Tree &tree) { tree.update_range(diff, l, r); });
+  }
+
+  /*
+   * @brief Replace element i and publish it
+   */
+  template <typename U>
+  void set(int64_t i, const U &x) {
+    write([&](Tree &tree) { tree.set(i, x); });
+  }
+
+  /*
+   * @brief Apply fn(Tree &) as one published step. fn runs twice, once per
+   *        copy, and must leave both copies equal, e.g. a batch of updates.
+   */
+  template <typename Fn>
+  void write(Fn &&fn) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    const int side = side_.load(std::memory_order_relaxed);
+    fn(trees_[side ^ 1]);
+    side_.store(side ^ 1, std::memory_order_seq_cst);
+
+    // Readers that loaded the old side_ arrived on the current indicator.
+    // Drain the other one first so no reader is left on an indicator that
+    // is skipped, then send new arrivals there and drain the current one.
+    const int current = indicator_.load(std::memory_order_relaxed);
+    wait_empty(current ^ 1);
+    indicator_.store(current ^ 1, std::memory_order_seq_cst);
+    wait_empty(current);
+
+    fn(trees_[side]);
+    version_.fetch_add(1, std::memory_order_release);
+  }
+
+  /*
+   * @brief Number of published writes
+   */
+  uint64_t version() const noexcept {
+    return version_.load(std::memory_order_acquire);
+  }
+
+  int64_t size() const noexcept {
+    return trees_[0].size();
+  }
+
+ private:
+  static constexpr size_t kSlots = 64;
+
+  struct alignas(64) Slot {
+    std::atomic<int64_t> readers{0};
+  };
+
+  // Threads are spread over the slots round robin on first use
+  static size_t slot_index() noexcept {
+    static std::atomic<size_t> next{0};
+    thread_local const size_t index =
+        next.fetch_add(1, std::memory_order_relaxed) % kSlots;
+    return index;
+  }
+
+  struct Guard {
+    explicit Guard(const ConcurrentSegmentTree &owner)
+        : self(owner), slot(slot_index()) {
+      indicator = self.indicator_.load(std::memory_order_seq_cst);
+      self.slots_[indicator][slot].readers.fetch_add(
+          1, std::memory_order_seq_cst);
+      side = self.side_.load(std::memory_order_seq_cst);
+    }
+
+    ~Guard() {
+      self.slots_[indicator][slot].readers.fetch_sub(
+          1, std::memory_order_release);
+    }
+
+    const ConcurrentSegmentTree &self;
+    size_t slot;
+    int indicator;
+    int side;
+  };
+
+  void wait_empty(int indicator) {
+    for (auto &slot : slots_[indicator]) {
+      SpinYieldWait<>().wait_until(
+          [&] { return slot.readers.load(std::memory_order_acquire) == 0; },
+          std::chrono::steady_clock::time_point::max());
+    }
+  }
+
+  Tree trees_[2];
+  std::atomic<int> side_{0};
+  std::atomic<int> indicator_{0};
+  mutable Slot slots_[2][kSlots];
+  std::atomic<uint64_t> version_{0};
+  std::mutex write_mutex_;
+};
+
+} // namespace container
+} // namespace sdk
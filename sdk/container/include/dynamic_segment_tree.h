@@ -0,0 +1,115 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file dynamic_segment_tree.h
+ * @brief A sparse segment tree over int64_t keys, nodes created on demand.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "container/node_pool.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <limits>
+
+namespace sdk {
+namespace container {
+
+// Segment tree over the keys [lo, hi], by default the whole int64_t range,
+// with range add, range sum and range max. Every key starts at 0.
+//
+// Only the nodes on the boundary paths of an update are created, from a
+// NodePool, so memory grows with the number of touched nodes (at most
+// ~2 * 64 per update over the full range), not with hi - lo. Pending adds
+// stay on the node they were applied to and queries add the adds of the
+// ancestors above a partial result, so queries never allocate and are const.
+//
+// Sums wrap around on int64_t overflow, e.g. when adding to a range wider
+// than 2^63 keys. All ranges are inclusive [l, r] and clipped to [lo, hi].
+class DynamicSegmentTree {
+ public:
+  explicit DynamicSegmentTree(
+      int64_t lo = std::numeric_limits<int64_t>::min(),
+      int64_t hi = std::numeric_limits<int64_t>::max());
+
+  /*
+   * @brief Add diff to every key of [l, r]
+   */
+  void update_range(int64_t diff, int64_t l, int64_t r);
+
+  /*
+   * @brief Add diff to one key
+   */
+  void add(int64_t key, int64_t diff) {
+    update_range(diff, key, key);
+  }
+
+  /*
+   * @brief Sum of [l, r], 0 for an empty range
+   */
+  int64_t query(int64_t l, int64_t r) const;
+
+  /*
+   * @brief Max of [l, r], INT64_MIN for an empty range
+   */
+  int64_t query_max(int64_t l, int64_t r) const;
+
+  /*
+   * @brief Reset every key to 0, keeping the pool's memory for reuse
+   */
+  void clear();
+
+  int64_t lo() const noexcept {
+    return lo_;
+  }
+
+  int64_t hi() const noexcept {
+    return hi_;
+  }
+
+  size_t node_count() const noexcept {
+    return pool_.size();
+  }
+
+  size_t memory_usage() const noexcept {
+    return pool_.capacity() * sizeof(Node);
+  }
+
+ private:
+  static constexpr uint32_t kNull = std::numeric_limits<uint32_t>::max();
+
+  // sum and max include the node's own pending add, not its ancestors'.
+  // A missing child is a range of zeros.
+  struct Node {
+    int64_t sum;
+    int64_t max;
+    int64_t lazy;
+    uint32_t left;
+    uint32_t right;
+  };
+
+  uint32_t update(uint32_t node, int64_t l, int64_t r, int64_t diff,
+                  int64_t ql, int64_t qr);
+
+  int64_t query(uint32_t node, int64_t l, int64_t r, int64_t ql,
+                int64_t qr) const;
+
+  int64_t query_max(uint32_t node, int64_t l, int64_t r, int64_t ql,
+                    int64_t qr) const;
+
+  // Clamp [l, r] to [lo, hi]
+  bool clip(int64_t &l, int64_t &r) const;
+
+  int64_t lo_;
+  int64_t hi_;
+  uint32_t root_ = kNull;
+  NodePool<Node> pool_;
+};
+
+} // namespace container
+} // namespace sdk
@@ -0,0 +1,181 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file fenwick_tree.h
+ * @brief Fenwick trees (binary indexed trees) for prefix and range sums.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vector>
+
+namespace sdk {
+namespace container {
+
+// Fenwick tree with point add and prefix/range sum, n values of T.
+//
+// A sum-only alternative to SegmentTree at one T per element instead of
+// three 4n arrays. Indices are 0-based, ranges inclusive [l, r] like
+// SegmentTree; internally the tree is 1-based.
+template <typename T = int64_t>
+class FenwickTree {
+ public:
+  explicit FenwickTree(size_t n) : tree_(n + 1, T{}) {}
+
+  /*
+   * @brief Build from data in O(n)
+   */
+  template <typename U>
+  explicit FenwickTree(const std::vector<U> &data) : tree_(data.size() + 1) {
+    const size_t n = data.size();
+    for (size_t i = 1; i <= n; ++i) {
+      tree_[i] = static_cast<T>(data[i - 1]);
+    }
+    // Each node hands its partial sum to its parent once
+    for (size_t i = 1; i <= n; ++i) {
+      const size_t parent = i + (i & (~i + 1));
+      if (parent <= n) tree_[parent] += tree_[i];
+    }
+  }
+
+  /*
+   * @brief Add delta to element i
+   */
+  void add(size_t i, T delta) noexcept {
+    for (++i; i < tree_.size(); i += i & (~i + 1)) {
+      tree_[i] += delta;
+    }
+  }
+
+  /*
+   * @brief Sum of [0, i], i past the end is clipped
+   */
+  T prefix_sum(size_t i) const noexcept {
+    T sum{};
+    if (i >= size()) i = size() - 1;
+    for (++i; i > 0; i &= i - 1) {
+      sum += tree_[i];
+    }
+    return sum;
+  }
+
+  /*
+   * @brief Sum of [l, r]
+   */
+  T query(int64_t l, int64_t r) const noexcept {
+    if (l < 0) l = 0;
+    if (r >= static_cast<int64_t>(size())) r = static_cast<int64_t>(size()) - 1;
+    if (l > r) return T{};
+    const T right = prefix_sum(static_cast<size_t>(r));
+    return l == 0 ? right : right - prefix_sum(static_cast<size_t>(l - 1));
+  }
+
+  /*
+   * @brief Smallest i with prefix_sum(i) >= k, all elements must be
+   *        non-negative. Finds the k-th unit when elements are counts.
+   * @return size_t, size() if the total is below k
+   */
+  size_t lower_bound(T k) const noexcept {
+    if (!(k > T{})) return 0;
+    size_t pos = 0;
+    size_t step = 1;
+    while (step * 2 < tree_.size()) step *= 2;
+    // Binary lifting: extend pos while the sum stays below k
+    for (; step > 0; step >>= 1) {
+      const size_t next = pos + step;
+      if (next < tree_.size() && tree_[next] < k) {
+        pos = next;
+        k -= tree_[next];
+      }
+    }
+    return pos;
+  }
+
+  size_t size() const noexcept {
+    return tree_.size() - 1;
+  }
+
+ private:
+  std::vector<T> tree_;
+};
+
+// Range add and range sum with two Fenwick trees over the difference array
+// d (a[i] = d[0] + ... + d[i]):
+//   a[0] + ... + a[p] = (p + 1) * sum(d[0..p]) - sum(j * d[j], j <= p)
+// so b1_ holds d[j] and b2_ holds j * d[j]. Two T per element.
+template <typename T = int64_t>
+class RangeFenwickTree {
+ public:
+  explicit RangeFenwickTree(size_t n) : b1_(n), b2_(n) {}
+
+  /*
+   * @brief Build from data in O(n)
+   */
+  template <typename U>
+  explicit RangeFenwickTree(const std::vector<U> &data)
+      : b1_(differences(data, false)), b2_(differences(data, true)) {}
+
+  /*
+   * @brief Add diff to every element of [l, r]
+   */
+  void update_range(T diff, int64_t l, int64_t r) noexcept {
+    const auto n = static_cast<int64_t>(size());
+    if (l < 0) l = 0;
+    if (r >= n) r = n - 1;
+    if (l > r) return;
+    b1_.add(static_cast<size_t>(l), diff);
+    b2_.add(static_cast<size_t>(l), diff * static_cast<T>(l));
+    if (r + 1 < n) {
+      b1_.add(static_cast<size_t>(r + 1), -diff);
+      b2_.add(static_cast<size_t>(r + 1), -diff * static_cast<T>(r + 1));
+    }
+  }
+
+  /*
+   * @brief Sum of [0, i]
+   */
+  T prefix_sum(size_t i) const noexcept {
+    if (i >= size()) i = size() - 1;
+    return static_cast<T>(i + 1) * b1_.prefix_sum(i) - b2_.prefix_sum(i);
+  }
+
+  /*
+   * @brief Sum of [l, r]
+   */
+  T query(int64_t l, int64_t r) const noexcept {
+    if (l < 0) l = 0;
+    if (r >= static_cast<int64_t>(size())) r = static_cast<int64_t>(size()) - 1;
+    if (l > r) return T{};
+    const T right = prefix_sum(static_cast<size_t>(r));
+    return l == 0 ? right : right - prefix_sum(static_cast<size_t>(l - 1));
+  }
+
+  size_t size() const noexcept {
+    return b1_.size();
+  }
+
+ private:
+  template <typename U>
+  static std::vector<T> differences(const std::vector<U> &data, bool scaled) {
+    std::vector<T> d(data.size());
+    T prev{};
+    for (size_t j = 0; j < data.size(); ++j) {
+      const auto v = static_cast<T>(data[j]);
+      d[j] = scaled ? (v - prev) * static_cast<T>(j) : v - prev;
+      prev = v;
+    }
+    return d;
+  }
+
+  FenwickTree<T> b1_;
+  FenwickTree<T> b2_;
+};
+
+} // namespace container
+} // namespace sdk
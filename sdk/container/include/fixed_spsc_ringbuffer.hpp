@@ -0,0 +1,301 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file fixed_spsc_ringbuffer.hpp
+ * @brief A SPSC ring buffer with compile-time power-of-two capacity.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "container/wait_strategy.hpp"
+#include "macro/macros.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace sdk {
+namespace container {
+
+// Thread-safe SPSC ring buffer with a constexpr power-of-two capacity.
+//
+// Differences from SPSCRingbuffer:
+// - head_/tail_ are free-running 64-bit counters, the slot index is
+//   counter & kMask, so push/pop never run an integer division.
+// - size is head_ - tail_, so all Capacity slots are usable (no wasted slot).
+// - Storage is always raw, elements are constructed in place and destroyed
+//   on pop/release; T does not need to be default-constructible.
+// - Wait is the push_wait/pop_wait strategy, see wait_strategy.hpp.
+template <typename T, size_t Capacity, typename Wait = SpinYieldWait<>>
+class FixedSPSCRingbuffer {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two and at least 2");
+
+ public:
+  FixedSPSCRingbuffer() noexcept
+      : data_(static_cast<T *>(::operator new(
+            sizeof(T) * Capacity, std::align_val_t{alignof(T)}))),
+        head_(0), tail_cache_(0), tail_(0), head_cache_(0) {}
+
+  ~FixedSPSCRingbuffer() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      const uint64_t head = head_.load(std::memory_order_acquire);
+      for (uint64_t i = tail_.load(std::memory_order_relaxed); i != head; ++i) {
+        std::destroy_at(slot(i));
+      }
+    }
+    ::operator delete(data_, std::align_val_t{alignof(T)});
+  }
+
+  DISALLOW_COPY_AND_MOVE(FixedSPSCRingbuffer);
+
+  bool try_push(const T &value) noexcept(
+      std::is_nothrow_copy_constructible_v<T>) {
+    return emplace(value);
+  }
+
+  bool try_push(T &&value) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    return emplace(std::move(value));
+  }
+
+  bool push(const T &value, int max_attempt) noexcept(
+      std::is_nothrow_copy_constructible_v<T>) {
+    for (auto i = 0; i < max_attempt; ++i) {
+      if (try_push(value)) {
+        return true;
+      }
+      std::this_thread::yield();
+    }
+    return false;
+  }
+
+  bool push(T &&value,
+            int max_attempt) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    for (auto i = 0; i < max_attempt; ++i) {
+      if (try_push(std::move(value))) {
+        return true;
+      }
+      std::this_thread::yield();
+    }
+    return false;
+  }
+
+  template <typename... Args>
+  bool emplace(Args &&...args) noexcept(
+      std::is_nothrow_constructible_v<T, Args...>) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_cache_ == Capacity) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head - tail_cache_ == Capacity) {
+        return false; // full
+      }
+    }
+    ::new (static_cast<void *>(slot(head))) T(std::forward<Args>(args)...);
+    head_.store(head + 1, std::memory_order_release);
+    not_empty_.notify();
+    return true;
+  }
+
+  /*
+   * @brief Get the next free slot, it is uninitialized storage and must be
+   *        constructed (e.g. placement new) before commit()
+   * @return T*, nullptr when full
+   */
+  T *reserve() noexcept {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_cache_ == Capacity) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head - tail_cache_ == Capacity) {
+        return nullptr;
+      }
+    }
+    return slot(head);
+  }
+
+  void commit() noexcept {
+    head_.store(head_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+    not_empty_.notify();
+  }
+
+  bool pop(T &value) noexcept(std::is_nothrow_move_assignable_v<T> &&
+                              std::is_nothrow_destructible_v<T>) {
+    T *t = front();
+    if (!t) {
+      return false;
+    }
+    value = std::move(*t);
+    release();
+    return true;
+  }
+
+  /*
+   * @brief Push, blocking with the Wait strategy while the ring is full
+   * @return bool, false when still full after timeout
+   */
+  template <class Rep, class Period>
+  bool push_wait(const T &value, std::chrono::duration<Rep, Period> timeout) {
+    if (try_push(value)) {
+      return true;
+    }
+    const auto deadline = deadline_after(timeout);
+    while (not_full_.wait_until([this] { return !full(); }, deadline)) {
+      if (try_push(value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <class Rep, class Period>
+  bool push_wait(T &&value, std::chrono::duration<Rep, Period> timeout) {
+    if (try_push(std::move(value))) {
+      return true;
+    }
+    const auto deadline = deadline_after(timeout);
+    while (not_full_.wait_until([this] { return !full(); }, deadline)) {
+      if (try_push(std::move(value))) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /*
+   * @brief Pop, blocking with the Wait strategy while the ring is empty
+   * @return bool, false when still empty after timeout
+   */
+  template <class Rep, class Period>
+  bool pop_wait(T &value, std::chrono::duration<Rep, Period> timeout) {
+    if (pop(value)) {
+      return true;
+    }
+    const auto deadline = deadline_after(timeout);
+    while (not_empty_.wait_until([this] { return !empty(); }, deadline)) {
+      if (pop(value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /*
+   * @brief Get the oldest element for reading in place, drop it with
+   *        release()
+   * @return T*, nullptr when empty
+   */
+  T *front() noexcept {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_cache_) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail == head_cache_) {
+        return nullptr;
+      }
+    }
+    return slot(tail);
+  }
+
+  void release() noexcept {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    std::destroy_at(slot(tail));
+    tail_.store(tail + 1, std::memory_order_release);
+    not_full_.notify();
+  }
+
+  /*
+   * @brief Push up to n elements from [first, first + n) with a single
+   *        publish of head_. Use std::make_move_iterator to move elements.
+   * @return size_t, number of elements pushed
+   */
+  template <typename InputIt>
+  size_t try_push_n(InputIt first, size_t n) noexcept(
+      std::is_nothrow_constructible_v<T, decltype(*first)>) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    if (Capacity - (head - tail_cache_) < n) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+    }
+    const size_t cnt = std::min<size_t>(n, Capacity - (head - tail_cache_));
+    for (size_t i = 0; i < cnt; ++i, ++first) {
+      ::new (static_cast<void *>(slot(head + i))) T(*first);
+    }
+    if (cnt != 0) {
+      head_.store(head + cnt, std::memory_order_release);
+      not_empty_.notify();
+    }
+    return cnt;
+  }
+
+  /*
+   * @brief Pop up to n elements into out with a single publish of tail_
+   * @return size_t, number of elements popped
+   */
+  template <typename OutputIt>
+  size_t pop_n(OutputIt out, size_t n) noexcept(
+      std::is_nothrow_assignable_v<decltype(*out), T &&>) {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (head_cache_ - tail < n) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+    }
+    const size_t cnt = std::min<size_t>(n, head_cache_ - tail);
+    for (size_t i = 0; i < cnt; ++i, ++out) {
+      T *t = slot(tail + i);
+      *out = std::move(*t);
+      std::destroy_at(t);
+    }
+    if (cnt != 0) {
+      tail_.store(tail + cnt, std::memory_order_release);
+      not_full_.notify();
+    }
+    return cnt;
+  }
+
+  size_t size() const noexcept {
+    const uint64_t t = tail_.load(std::memory_order_acquire);
+    const uint64_t h = head_.load(std::memory_order_acquire);
+    return static_cast<size_t>(h - t);
+  }
+
+  bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  bool full() const noexcept {
+    return size() == Capacity;
+  }
+
+  static constexpr size_t capacity() noexcept {
+    return Capacity;
+  }
+
+ private:
+  static constexpr uint64_t kMask = Capacity - 1;
+
+  T *slot(uint64_t counter) const noexcept {
+    return data_ + (counter & kMask);
+  }
+
+  T *const data_;
+  // Producer side: head_ is published, tail_cache_ is a private copy of tail_
+  alignas(64) std::atomic<uint64_t> head_;
+  uint64_t tail_cache_;
+  // Consumer side: tail_ is published, head_cache_ is a private copy of head_
+  alignas(64) std::atomic<uint64_t> tail_;
+  uint64_t head_cache_;
+  // Consumer waits on not_empty_, producer waits on not_full_
+  alignas(64) Wait not_empty_;
+  Wait not_full_;
+};
+
+} // namespace container
+} // namespace sdk
@@ -0,0 +1,93 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file iterative_segment_tree.h
+ * @brief A non-recursive bottom-up segment tree with range add.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vector>
+
+namespace sdk {
+namespace container {
+
+// Bottom-up segment tree over 2n nodes (range add, range sum and max)
+//
+// Leaves live at [n, 2n), node p has children 2p and 2p + 1, for any n.
+// sum, max and the pending add of a node sit together in one 32-byte Node,
+// so visiting a node touches a single cache line.
+//
+// A node's sum/max include every add applied to it or below it; its lazy is
+// the add still owed to its children. Queries never push lazies down:
+// walking up from the two boundaries they add the lazies of the ancestors
+// above the nodes already taken, so query() is const and safe to run from
+// several threads while no update is in progress.
+//
+// All indices are inclusive [l, r], like SegmentTree.
+class IterativeSegmentTree {
+ public:
+  template <typename U>
+  explicit IterativeSegmentTree(const std::vector<U> &data)
+      : n_(static_cast<int64_t>(data.size())), nodes_(data.size() * 2) {
+    for (int64_t i = 0; i < n_; ++i) {
+      const auto v = static_cast<int64_t>(data[i]);
+      nodes_[n_ + i] = Node{v, v, 0};
+    }
+    build();
+  }
+
+  /*
+   * @brief Sum of [l, r], 0 for an empty range
+   */
+  int64_t query(int64_t l, int64_t r) const;
+
+  /*
+   * @brief Max of [l, r], INT64_MIN for an empty range
+   */
+  int64_t query_max(int64_t l, int64_t r) const;
+
+  /*
+   * @brief Add diff to every element of [l, r]
+   */
+  void update_range(int64_t diff, int64_t l, int64_t r);
+
+  int64_t size() const noexcept {
+    return n_;
+  }
+
+  /*
+   * For debug
+   */
+  std::vector<int64_t> toArray() const;
+
+ private:
+  struct alignas(32) Node {
+    int64_t sum;
+    int64_t max;
+    int64_t lazy;
+  };
+
+  void build();
+
+  // Add diff to node p covering k leaves
+  void apply(int64_t p, int64_t diff, int64_t k);
+
+  // Recompute the ancestors of leaf p after its subtree changed
+  void rebuild(int64_t p);
+
+  // Clamp [l, r] to the array and convert to leaf indices [l, r)
+  bool leaves(int64_t &l, int64_t &r) const;
+
+  int64_t n_;
+  std::vector<Node> nodes_;
+};
+
+} // namespace container
+} // namespace sdk
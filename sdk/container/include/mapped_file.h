@@ -0,0 +1,79 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file mapped_file.h
+ * @brief A file mapped copy-on-write, and atomic file snapshots.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "macro/macros.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <memory>
+#include <span>
+#include <string>
+
+namespace sdk {
+namespace container {
+
+class MappedFile {
+ public:
+  ~MappedFile();
+
+  /*
+   * @brief Map a whole file readable and privately writable: writes land in
+   *        copy-on-write pages of this process and never reach the file.
+   *        Pages are read in on first touch, so opening costs the same for
+   *        any file size.
+   * @return std::unique_ptr<MappedFile>, nullptr on failure (errno is set)
+   */
+  static std::unique_ptr<MappedFile> OpenPrivate(const std::string &path);
+
+  // size bytes of data to be placed at offset
+  struct Chunk {
+    uint64_t offset;
+    const void *data;
+    size_t size;
+  };
+
+  /*
+   * @brief Write chunks into path + ".tmp", fsync it and rename it over
+   *        path, so readers see either the old file or the complete new
+   *        one. Gaps between chunks read as zeros. Mappings of the old file
+   *        stay valid.
+   * @return bool, false on failure (errno is set)
+   */
+  static bool WriteAtomic(const std::string &path,
+                          std::span<const Chunk> chunks);
+
+  void *data() const {
+    return data_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+ private:
+  MappedFile(void *data, size_t size);
+
+  void *data_;
+  size_t size_;
+
+  DISALLOW_COPY_AND_MOVE(MappedFile);
+};
+
+/*
+ * @brief 64-bit checksum of size bytes, chain calls through seed. Catches
+ *        corruption and truncation, not meant to resist tampering.
+ */
+uint64_t checksum64(const void *data, size_t size, uint64_t seed = 0);
+
+} // namespace container
+} // namespace sdk
@@ -0,0 +1,95 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file mpmc_queue.hpp
+ * @brief A bounded lock-free multi-producer multi-consumer queue.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "container/sequenced_ring.hpp"
+#include "container/wait_strategy.hpp"
+#include "macro/macros.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <type_traits>
+
+namespace sdk {
+namespace container {
+
+// Bounded lock-free MPMC queue (Vyukov style)
+//
+// Producers claim cells as described in SequencedRing, consumers CAS
+// tail_. Each cell sits on its own cache line so neighbouring
+// producers/consumers do not false share.
+template <typename T, typename Wait = SpinYieldWait<>>
+class MPMCQueue : public SequencedRing<T, Wait, 64> {
+  using Ring = SequencedRing<T, Wait, 64>;
+  using Cell = typename Ring::Cell;
+  using Ring::cells_;
+  using Ring::mask_;
+  using Ring::not_empty_;
+  using Ring::not_full_;
+  using Ring::tail_;
+  using Ring::take;
+
+ public:
+  explicit MPMCQueue(size_t size) : Ring(size) {}
+
+  DISALLOW_COPY_AND_MOVE(MPMCQueue);
+
+  /*
+   * @brief Pop one element, safe to call from many consumers
+   * @return bool, false when empty
+   */
+  bool pop(T &value) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell &cell = cells_[pos & mask_];
+      const size_t seq = cell.seq.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          take(cell, pos, value);
+          not_full_.notify();
+          return true;
+        }
+      } else if (diff < 0) {
+        return false; // empty
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /*
+   * @brief Pop, blocking with the Wait strategy while the queue is empty
+   * @return bool, false when still empty after timeout
+   */
+  template <class Rep, class Period>
+  bool pop_wait(T &value, std::chrono::duration<Rep, Period> timeout) {
+    if (pop(value)) {
+      return true;
+    }
+    const auto deadline = deadline_after(timeout);
+    while (not_empty_.wait_until([this] { return !this->empty(); },
+                                 deadline)) {
+      if (pop(value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+} // namespace container
+} // namespace sdk
@@ -0,0 +1,112 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file mpsc_queue.hpp
+ * @brief A bounded lock-free multi-producer single-consumer queue.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "container/sequenced_ring.hpp"
+#include "container/wait_strategy.hpp"
+#include "macro/macros.h"
+
+#include <chrono>
+#include <cstddef>
+
+#include <atomic>
+#include <type_traits>
+
+namespace sdk {
+namespace container {
+
+// Bounded lock-free MPSC queue (multi-producer single-consumer)
+//
+// Producers claim cells as described in SequencedRing, the single consumer
+// owns tail_ and never needs a CAS.
+//
+// try_push/push/emplace may be called from any thread, pop/pop_n only from
+// one consumer thread at a time.
+template <typename T, typename Wait = SpinYieldWait<>>
+class MPSCQueue
+    : public SequencedRing<T, Wait, alignof(std::atomic<size_t>)> {
+  using Ring = SequencedRing<T, Wait, alignof(std::atomic<size_t>)>;
+  using Cell = typename Ring::Cell;
+  using Ring::cells_;
+  using Ring::mask_;
+  using Ring::not_empty_;
+  using Ring::not_full_;
+  using Ring::tail_;
+  using Ring::take;
+
+ public:
+  explicit MPSCQueue(size_t size) : Ring(size) {}
+
+  DISALLOW_COPY_AND_MOVE(MPSCQueue);
+
+  /*
+   * @brief Pop one element, consumer thread only
+   * @return bool, false when empty or the next element is not published yet
+   */
+  bool pop(T &value) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    const size_t pos = tail_.load(std::memory_order_relaxed);
+    Cell &cell = cells_[pos & mask_];
+    if (cell.seq.load(std::memory_order_acquire) != pos + 1) {
+      return false;
+    }
+    take(cell, pos, value);
+    tail_.store(pos + 1, std::memory_order_relaxed);
+    not_full_.notify();
+    return true;
+  }
+
+  /*
+   * @brief Pop up to n consecutive published elements, consumer thread only
+   * @param OutputIt out
+   * @param size_t n
+   * @return size_t, number of elements popped
+   */
+  template <typename OutputIt>
+  size_t pop_n(OutputIt out, size_t n) noexcept(
+      std::is_nothrow_assignable_v<decltype(*out), T &&>) {
+    const size_t start = tail_.load(std::memory_order_relaxed);
+    size_t pos = start;
+    for (; pos - start < n; ++pos, ++out) {
+      Cell &cell = cells_[pos & mask_];
+      if (cell.seq.load(std::memory_order_acquire) != pos + 1) {
+        break;
+      }
+      take(cell, pos, *out);
+    }
+    if (pos != start) {
+      tail_.store(pos, std::memory_order_relaxed);
+      not_full_.notify();
+    }
+    return pos - start;
+  }
+
+  /*
+   * @brief Pop, blocking with the Wait strategy while the queue is empty
+   * @return bool, false when still empty after timeout
+   */
+  template <class Rep, class Period>
+  bool pop_wait(T &value, std::chrono::duration<Rep, Period> timeout) {
+    if (pop(value)) {
+      return true;
+    }
+    const auto deadline = deadline_after(timeout);
+    while (not_empty_.wait_until([this] { return !this->empty(); },
+                                 deadline)) {
+      if (pop(value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+} // namespace container
+} // namespace sdk
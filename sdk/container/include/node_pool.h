@@ -0,0 +1,66 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file node_pool.h
+ * @brief A chunked bump allocator for tree nodes addressed by index.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <memory>
+#include <vector>
+
+namespace sdk {
+namespace container {
+
+// Nodes are bump-allocated from chunks of 2^ChunkShift nodes and referred to
+// by 32-bit index, half the size of a pointer and stable across growth.
+// Nothing is freed one by one: clear() rewinds the pool and keeps its
+// chunks for reuse, destruction releases them all at once.
+template <typename Node, size_t ChunkShift = 12>
+class NodePool {
+ public:
+  static constexpr size_t kChunkNodes = size_t{1} << ChunkShift;
+
+  uint32_t alloc(const Node &node) {
+    if ((size_ >> ChunkShift) == chunks_.size()) {
+      chunks_.emplace_back(new Node[kChunkNodes]);
+    }
+    const auto index = static_cast<uint32_t>(size_++);
+    (*this)[index] = node;
+    return index;
+  }
+
+  Node &operator[](uint32_t i) noexcept {
+    return chunks_[i >> ChunkShift][i & (kChunkNodes - 1)];
+  }
+
+  const Node &operator[](uint32_t i) const noexcept {
+    return chunks_[i >> ChunkShift][i & (kChunkNodes - 1)];
+  }
+
+  void clear() noexcept {
+    size_ = 0;
+  }
+
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  size_t capacity() const noexcept {
+    return chunks_.size() * kChunkNodes;
+  }
+
+ private:
+  std::vector<std::unique_ptr<Node[]>> chunks_;
+  size_t size_ = 0;
+};
+
+} // namespace container
+} // namespace sdk
@@ -0,0 +1,287 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file persistent_segment_tree.h
+ * @brief A versioned segment tree with path copying on an arena.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "container/node_pool.h"
+#include "container/segment_tree.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace sdk {
+namespace container {
+
+// Persistent segment tree: every update creates a new version and old
+// versions stay queryable
+//
+// Updates copy the O(log n) nodes on their paths and share the rest with
+// the previous version. Nodes live in a NodePool arena and refer to each
+// other by 32-bit index, so an update does no per-node new and a node costs
+// sizeof(value_type) + sizeof(tag_type) + 8.
+//
+// Range updates keep their tags on the copied nodes instead of pushing them
+// down (a node's aggregate includes its own tag, not its ancestors'), and
+// queries apply the tags above a partial result like SegmentTree does.
+// Op and LazyOp are the same as for SegmentTree.
+//
+// Version 0 is the built array, each update_range()/set() returns the next
+// version. release_before(v) drops older versions and copies the nodes
+// still reachable into a fresh arena, releasing the old one in bulk.
+//
+// All indices are inclusive [l, r]. Not thread-safe.
+template <typename T = int64_t, typename Op = StatsOp<T>,
+          typename LazyOp = RangeAdd<Op>>
+class PersistentSegmentTree {
+ public:
+  using value_type = typename Op::value_type;
+  using result_type = typename Op::result_type;
+  using tag_type = typename LazyOp::tag_type;
+
+  template <typename U>
+  explicit PersistentSegmentTree(const std::vector<U> &data)
+      : size_(static_cast<int64_t>(data.size())) {
+    roots_.push_back(size_ > 0 ? build(data, 0, size_ - 1) : kNull);
+  }
+
+  /*
+   * @brief Aggregate of [l, r] as of version v, as reported by Op
+   * @return result_type, Op::identity() for an empty intersection or a
+   *         version that was released or does not exist yet
+   */
+  result_type query(uint64_t version, int64_t l, int64_t r) const {
+    return Op::result(aggregate(version, l, r));
+  }
+
+  /*
+   * @brief Aggregate of [l, r] in the latest version
+   */
+  result_type query(int64_t l, int64_t r) const {
+    return query(version(), l, r);
+  }
+
+  value_type aggregate(uint64_t version, int64_t l, int64_t r) const {
+    if (!has_version(version)) return Op::identity();
+    const uint32_t root = roots_[version - first_version_];
+    if (root == kNull) return Op::identity();
+    // Clamp first, so tags never see a negative length
+    l = std::max<int64_t>(l, 0);
+    r = std::min<int64_t>(r, size_ - 1);
+    if (l > r) return Op::identity();
+    return query_range(root, 0, size_ - 1, l, r);
+  }
+
+  /*
+   * @brief Apply diff to every element of [l, r] of the latest version
+   * @return uint64_t, the new version
+   */
+  uint64_t update_range(tag_type diff, int64_t l, int64_t r) {
+    uint32_t root = roots_.back();
+    if (root != kNull) {
+      root = update_range(root, 0, size_ - 1, diff, l, r);
+    }
+    roots_.push_back(root);
+    return version();
+  }
+
+  /*
+   * @brief Replace element i of the latest version
+   * @return uint64_t, the new version
+   */
+  template <typename U>
+  uint64_t set(int64_t i, const U &x) {
+    uint32_t root = roots_.back();
+    if (root != kNull && i >= 0 && i < size_) {
+      root = set(root, 0, size_ - 1, i, Op::leaf(x));
+    }
+    roots_.push_back(root);
+    return version();
+  }
+
+  /*
+   * @brief Drop every version before v (the latest is always kept) and
+   *        compact the arena to the nodes the remaining versions use
+   */
+  void release_before(uint64_t v) {
+    v = std::min(v, version());
+    if (v <= first_version_) return;
+    roots_.erase(roots_.begin(),
+                 roots_.begin() + static_cast<ptrdiff_t>(v - first_version_));
+    first_version_ = v;
+
+    Arena old;
+    std::swap(old, arena_);
+    std::vector<uint32_t> moved(old.size(), kNull);
+    for (auto &root : roots_) {
+      if (root != kNull) root = copy(old, moved, root);
+    }
+  }
+
+  /*
+   * @brief Latest version
+   */
+  uint64_t version() const noexcept {
+    return first_version_ + roots_.size() - 1;
+  }
+
+  /*
+   * @brief Oldest version still queryable
+   */
+  uint64_t oldest_version() const noexcept {
+    return first_version_;
+  }
+
+  bool has_version(uint64_t v) const noexcept {
+    return v >= first_version_ && v <= version();
+  }
+
+  int64_t size() const noexcept {
+    return size_;
+  }
+
+  size_t node_count() const noexcept {
+    return arena_.size();
+  }
+
+  size_t memory_usage() const noexcept {
+    return arena_.capacity() * sizeof(Node);
+  }
+
+  /*
+   * For debug
+   */
+  std::vector<result_type> toArray(uint64_t v) const {
+    std::vector<result_type> res(size_);
+    for (int64_t i = 0; i < size_; ++i) {
+      res[i] = query(v, i, i);
+    }
+    return res;
+  }
+
+ private:
+  static constexpr uint32_t kNull = std::numeric_limits<uint32_t>::max();
+
+  struct Node {
+    value_type value;
+    tag_type tag;
+    uint32_t left;
+    uint32_t right;
+  };
+
+  using Arena = NodePool<Node>;
+
+  template <typename U>
+  uint32_t build(const std::vector<U> &data, int64_t l, int64_t r) {
+    if (l == r) {
+      return arena_.alloc(
+          {Op::leaf(data[l]), LazyOp::identity(), kNull, kNull});
+    }
+    auto mid = l + ((r - l) >> 1);
+    const uint32_t left = build(data, l, mid);
+    const uint32_t right = build(data, mid + 1, r);
+    return arena_.alloc({Op::combine(arena_[left].value, arena_[right].value),
+                         LazyOp::identity(), left, right});
+  }
+
+  value_type query_range(uint32_t node, int64_t l, int64_t r, int64_t ql,
+                         int64_t qr) const {
+    if (l > qr || r < ql) {
+      return Op::identity();
+    }
+    const Node &n = arena_[node];
+    if (l >= ql && r <= qr) {
+      return n.value;
+    }
+    auto mid = l + ((r - l) >> 1);
+    value_type res = Op::combine(query_range(n.left, l, mid, ql, qr),
+                                 query_range(n.right, mid + 1, r, ql, qr));
+    if (!(n.tag == LazyOp::identity())) {
+      const auto len = std::min(r, qr) - std::max(l, ql) + 1;
+      LazyOp::apply(res, n.tag, static_cast<size_t>(len));
+    }
+    return res;
+  }
+
+  // Copy of node with tag applied to its whole range
+  uint32_t tagged(uint32_t node, const tag_type &tag, int64_t len) {
+    Node n = arena_[node];
+    LazyOp::apply(n.value, tag, static_cast<size_t>(len));
+    n.tag = LazyOp::compose(n.tag, tag);
+    return arena_.alloc(n);
+  }
+
+  uint32_t update_range(uint32_t node, int64_t l, int64_t r,
+                        const tag_type &diff, int64_t ql, int64_t qr) {
+    if (qr < l || ql > r) {
+      return node;
+    }
+    if (l >= ql && r <= qr) {
+      return tagged(node, diff, r - l + 1);
+    }
+    Node n = arena_[node];
+    auto mid = l + ((r - l) >> 1);
+    n.left = update_range(n.left, l, mid, diff, ql, qr);
+    n.right = update_range(n.right, mid + 1, r, diff, ql, qr);
+    n.value = Op::combine(arena_[n.left].value, arena_[n.right].value);
+    if (!(n.tag == LazyOp::identity())) {
+      LazyOp::apply(n.value, n.tag, static_cast<size_t>(r - l + 1));
+    }
+    return arena_.alloc(n);
+  }
+
+  // The tags above the leaf would apply to the new value too, so they are
+  // pushed into copies of the children along the path
+  uint32_t set(uint32_t node, int64_t l, int64_t r, int64_t i,
+               const value_type &v) {
+    if (l == r) {
+      return arena_.alloc({v, LazyOp::identity(), kNull, kNull});
+    }
+    Node n = arena_[node];
+    auto mid = l + ((r - l) >> 1);
+    if (!(n.tag == LazyOp::identity())) {
+      n.left = tagged(n.left, n.tag, mid - l + 1);
+      n.right = tagged(n.right, n.tag, r - mid);
+      n.tag = LazyOp::identity();
+    }
+    if (i <= mid) {
+      n.left = set(n.left, l, mid, i, v);
+    } else {
+      n.right = set(n.right, mid + 1, r, i, v);
+    }
+    n.value = Op::combine(arena_[n.left].value, arena_[n.right].value);
+    return arena_.alloc(n);
+  }
+
+  // Copy the subtree at node from old into arena_, once per shared node
+  uint32_t copy(const Arena &old, std::vector<uint32_t> &moved,
+                uint32_t node) {
+    if (moved[node] != kNull) return moved[node];
+    Node n = old[node];
+    if (n.left != kNull) {
+      n.left = copy(old, moved, n.left);
+      n.right = copy(old, moved, n.right);
+    }
+    moved[node] = arena_.alloc(n);
+    return moved[node];
+  }
+
+  Arena arena_;
+  // roots_[i] is the root of version first_version_ + i
+  std::vector<uint32_t> roots_;
+  uint64_t first_version_ = 0;
+  int64_t size_;
+};
+
+} // namespace container
+} // namespace sdk
@@ -0,0 +1,108 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file prefix_sum_array.h
+ * @brief O(1) range sums over a read-only array.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace sdk {
+namespace container {
+
+// Prefix sums of a read-only array: sums_[i] is the sum of [0, i), so any
+// range sum is two loads and a subtraction. n + 1 values of memory.
+//
+// For int64_t the scan is vectorized with AVX2 when the target has it:
+// each 4-lane vector is prefix-summed in register with two shifted adds
+// and offset by the running total, instead of one dependent add per
+// element.
+template <typename T = int64_t>
+class PrefixSumArray {
+ public:
+  template <typename U>
+  explicit PrefixSumArray(const std::vector<U> &data)
+      : sums_(data.size() + 1) {
+    sums_[0] = T{};
+    std::transform(data.begin(), data.end(), sums_.begin() + 1,
+                   [](const U &x) { return static_cast<T>(x); });
+    inclusive_scan(sums_.data() + 1, data.size());
+  }
+
+  /*
+   * @brief Sum of [l, r], 0 for an empty range
+   */
+  T query(int64_t l, int64_t r) const noexcept {
+    l = std::max<int64_t>(l, 0);
+    r = std::min<int64_t>(r, size() - 1);
+    if (l > r) return T{};
+    return sums_[r + 1] - sums_[l];
+  }
+
+  /*
+   * @brief Sum of [0, i]
+   */
+  T prefix_sum(int64_t i) const noexcept {
+    return query(0, i);
+  }
+
+  int64_t size() const noexcept {
+    return static_cast<int64_t>(sums_.size()) - 1;
+  }
+
+  size_t memory_usage() const noexcept {
+    return sums_.size() * sizeof(T);
+  }
+
+ private:
+  static void inclusive_scan(T *p, size_t n) noexcept {
+    size_t i = 0;
+    T carry{};
+#if defined(__AVX2__)
+    if constexpr (std::is_same_v<T, int64_t>) {
+      const __m256i zero = _mm256_setzero_si256();
+      __m256i total = zero;
+      for (; i + 4 <= n; i += 4) {
+        auto *lane = reinterpret_cast<__m256i *>(p + i);
+        __m256i x = _mm256_loadu_si256(lane);
+        // [a, b, c, d] + [0, a, b, c] + [0, 0, a, a + b]
+        x = _mm256_add_epi64(
+            x, _mm256_blend_epi32(
+                   _mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 0)),
+                   zero, 0x03));
+        x = _mm256_add_epi64(
+            x, _mm256_blend_epi32(
+                   _mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 0, 0, 0)),
+                   zero, 0x0F));
+        x = _mm256_add_epi64(x, total);
+        _mm256_storeu_si256(lane, x);
+        total = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3));
+      }
+      if (i > 0) carry = p[i - 1];
+    }
+#endif
+    for (; i < n; ++i) {
+      carry += p[i];
+      p[i] = carry;
+    }
+  }
+
+  std::vector<T> sums_;
+};
+
+} // namespace container
+} // namespace sdk
@@ -10,62 +10,789 @@
 
 #pragma once
 
+#include "container/mapped_file.h"
+
+#include <cerrno>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace sdk {
 namespace container {
 
-class SegmentTree {
- private:
-  std::vector<int64_t> tree_sum;
-  std::vector<int64_t> tree_max;
-  std::vector<int64_t> lazy;
-  int64_t size;
+// Aggregation ops
+//
+// An Op describes what a node stores and how two children merge:
+//   using value_type;                  node aggregate
+//   using result_type;                 what query() returns
+//   static value_type identity();      aggregate of an empty range
+//   static value_type leaf(x);         aggregate of one input element
+//   static value_type combine(a, b);   a covers the range left of b
+//   static result_type result(v);
+//
+// A LazyOp describes a pending range update:
+//   using tag_type;
+//   static tag_type identity();
+//   static tag_type compose(older, newer);
+//   static void apply(value_type &v, tag_type tag, size_t len);
+// apply() must work on the aggregate of any len consecutive elements, so
+// the tag can be applied to a partial query result as well as to a node.
+
+template <typename T>
+struct RangeStats {
+  T sum;
+  T min;
+  T max;
+};
+
+template <typename T>
+struct SumOp {
+  using value_type = T;
+  using result_type = T;
+  static T identity() noexcept {
+    return T{};
+  }
+  template <typename U>
+  static T leaf(const U &x) noexcept {
+    return static_cast<T>(x);
+  }
+  static T combine(const T &a, const T &b) noexcept {
+    return a + b;
+  }
+  static T result(const T &v) noexcept {
+    return v;
+  }
+};
+
+template <typename T>
+struct MinOp {
+  using value_type = T;
+  using result_type = T;
+  static T identity() noexcept {
+    return std::numeric_limits<T>::max();
+  }
+  template <typename U>
+  static T leaf(const U &x) noexcept {
+    return static_cast<T>(x);
+  }
+  static T combine(const T &a, const T &b) noexcept {
+    return std::min(a, b);
+  }
+  static T result(const T &v) noexcept {
+    return v;
+  }
+};
+
+template <typename T>
+struct MaxOp {
+  using value_type = T;
+  using result_type = T;
+  static T identity() noexcept {
+    return std::numeric_limits<T>::lowest();
+  }
+  template <typename U>
+  static T leaf(const U &x) noexcept {
+    return static_cast<T>(x);
+  }
+  static T combine(const T &a, const T &b) noexcept {
+    return std::max(a, b);
+  }
+  static T result(const T &v) noexcept {
+    return v;
+  }
+};
+
+// Sum, min and max together; query() reports the sum
+template <typename T>
+struct StatsOp {
+  using value_type = RangeStats<T>;
+  using result_type = T;
+  static value_type identity() noexcept {
+    return {T{}, std::numeric_limits<T>::max(),
+            std::numeric_limits<T>::lowest()};
+  }
+  template <typename U>
+  static value_type leaf(const U &x) noexcept {
+    const auto v = static_cast<T>(x);
+    return {v, v, v};
+  }
+  static value_type combine(const value_type &a,
+                            const value_type &b) noexcept {
+    return {a.sum + b.sum, std::min(a.min, b.min), std::max(a.max, b.max)};
+  }
+  static T result(const value_type &v) noexcept {
+    return v.sum;
+  }
+};
+
+// Range add, specialized per Op because a sum grows with the range length
+// while min and max do not
+template <typename Op>
+struct RangeAdd;
+
+template <typename T>
+struct RangeAddBase {
+  using tag_type = T;
+  static T identity() noexcept {
+    return T{};
+  }
+  static T compose(const T &older, const T &newer) noexcept {
+    return older + newer;
+  }
+};
+
+template <typename T>
+struct RangeAdd<SumOp<T>> : RangeAddBase<T> {
+  static void apply(T &v, const T &tag, size_t len) noexcept {
+    v += tag * static_cast<T>(len);
+  }
+};
+
+template <typename T>
+struct RangeAdd<MinOp<T>> : RangeAddBase<T> {
+  static void apply(T &v, const T &tag, size_t len) noexcept {
+    if (len != 0) v += tag;
+  }
+};
+
+template <typename T>
+struct RangeAdd<MaxOp<T>> : RangeAddBase<T> {
+  static void apply(T &v, const T &tag, size_t len) noexcept {
+    if (len != 0) v += tag;
+  }
+};
 
+template <typename T>
+struct RangeAdd<StatsOp<T>> : RangeAddBase<T> {
+  static void apply(RangeStats<T> &v, const T &tag, size_t len) noexcept {
+    if (len == 0) return;
+    v.sum += tag * static_cast<T>(len);
+    v.min += tag;
+    v.max += tag;
+  }
+};
+
+// For custom aggregates without range updates, only set() is available
+template <typename Op>
+struct NoLazy {
+  struct tag_type {
+    bool operator==(const tag_type &) const noexcept {
+      return true;
+    }
+  };
+  static tag_type identity() noexcept {
+    return {};
+  }
+  static tag_type compose(const tag_type &, const tag_type &) noexcept {
+    return {};
+  }
+  static void apply(typename Op::value_type &, const tag_type &,
+                    size_t) noexcept {}
+};
+
+// Recursive segment tree with lazy propagation over 4n nodes.
+//
+// SegmentTree<> (int64_t values, StatsOp, RangeAdd) is the sum tree: query()
+// returns the sum, query_min()/query_max() stay correct under
+// update_range(). Other aggregates plug in through Op/LazyOp, e.g.
+//   SegmentTree<int64_t, MaxOp<int64_t>> max_tree(data);
+// All indices are inclusive [l, r]; queries do not modify the tree, so any
+// number of threads may query while no update is in progress.
+//
+// save() writes the node arrays to a snapshot file and open_mmap() maps one
+// back, queryable at once without a rebuild; see SnapshotHeader for the
+// format.
+template <typename T = int64_t, typename Op = StatsOp<T>,
+          typename LazyOp = RangeAdd<Op>>
+class SegmentTree {
  public:
-  SegmentTree(const std::vector<int> &data);
+  using value_type = typename Op::value_type;
+  using result_type = typename Op::result_type;
+  using tag_type = typename LazyOp::tag_type;
+
+  template <typename U>
+  explicit SegmentTree(const std::vector<U> &data)
+      : size_(static_cast<int64_t>(data.size())) {
+    tree_.assign(data.size() * 4, Op::identity());
+    lazy_.assign(data.size() * 4, LazyOp::identity());
+    nodes_ = tree_.data();
+    tags_ = lazy_.data();
+    if (size_ > 0) {
+      build(data, 1, 0, size_ - 1);
+    }
+  }
+
+  // A copy of a mapped tree owns its nodes in memory
+  SegmentTree(const SegmentTree &other)
+      : tree_(other.nodes_, other.nodes_ + other.node_count()),
+        lazy_(other.tags_, other.tags_ + other.node_count()),
+        nodes_(tree_.data()),
+        tags_(lazy_.data()),
+        size_(other.size_) {}
+
+  SegmentTree(SegmentTree &&other) noexcept
+      : tree_(std::move(other.tree_)),
+        lazy_(std::move(other.lazy_)),
+        nodes_(std::exchange(other.nodes_, nullptr)),
+        tags_(std::exchange(other.tags_, nullptr)),
+        mapped_(std::move(other.mapped_)),
+        size_(std::exchange(other.size_, 0)) {}
+
+  SegmentTree &operator=(const SegmentTree &other) {
+    if (this != &other) *this = SegmentTree(other);
+    return *this;
+  }
+
+  SegmentTree &operator=(SegmentTree &&other) noexcept {
+    tree_ = std::move(other.tree_);
+    lazy_ = std::move(other.lazy_);
+    nodes_ = std::exchange(other.nodes_, nullptr);
+    tags_ = std::exchange(other.tags_, nullptr);
+    mapped_ = std::move(other.mapped_);
+    size_ = std::exchange(other.size_, 0);
+    return *this;
+  }
+
+  /*
+   * @brief Write the tree, pending tags included, to a snapshot file. The
+   *        file is replaced atomically, trees mapped from it stay valid.
+   * @return bool, false on failure (errno is set)
+   */
+  bool save(const std::string &path) const {
+    static_assert(std::is_trivially_copyable_v<value_type> &&
+                      std::is_trivially_copyable_v<tag_type>,
+                  "snapshots need trivially copyable nodes");
+    const uint64_t count = node_count();
+    SnapshotHeader h = header(count);
+    h.payload_checksum = payload_checksum(nodes_, tags_, count);
+    h.header_checksum = header_checksum(h);
+    const MappedFile::Chunk chunks[] = {
+        {0, &h, sizeof(h)},
+        {h.nodes_offset, nodes_, count * sizeof(value_type)},
+        {h.tags_offset, tags_, count * sizeof(tag_type)},
+    };
+    return MappedFile::WriteAtomic(path, chunks);
+  }
 
-  int query(int l, int r);
+  /*
+   * @brief Map a snapshot written by save() with the same T, Op and LazyOp
+   *        (checked through SnapshotHeader::type_id).
+   *        Only the header is read, node pages are faulted in by the
+   *        queries that touch them, so opening is O(1) in the tree size.
+   *        Updates write to private copy-on-write pages and never reach
+   *        the file; save() again to keep them.
+   * @param bool verify, also check the node checksum, reading every page
+   * @return std::unique_ptr<SegmentTree>, nullptr on failure (errno is set,
+   *         EINVAL for a foreign or incompatible file, EBADMSG for a
+   *         checksum mismatch)
+   */
+  static std::unique_ptr<SegmentTree> open_mmap(const std::string &path,
+                                                bool verify = false) {
+    auto file = MappedFile::OpenPrivate(path);
+    if (!file) return nullptr;
+    SnapshotHeader h;
+    if (file->size() < sizeof(h)) {
+      errno = EINVAL;
+      return nullptr;
+    }
+    std::memcpy(&h, file->data(), sizeof(h));
+    const uint64_t count = h.node_count;
+    const SnapshotHeader expect = header(count);
+    if (std::memcmp(h.magic, expect.magic, sizeof(h.magic)) != 0 ||
+        h.format_version != expect.format_version ||
+        h.byte_order != expect.byte_order ||
+        h.value_size != expect.value_size || h.tag_size != expect.tag_size ||
+        h.type_id != expect.type_id ||
+        h.size * 4 != count || h.nodes_offset != expect.nodes_offset ||
+        h.tags_offset != expect.tags_offset ||
+        h.file_size != expect.file_size || h.file_size != file->size()) {
+      errno = EINVAL;
+      return nullptr;
+    }
+    auto *base = static_cast<unsigned char *>(file->data());
+    auto *nodes = reinterpret_cast<value_type *>(base + h.nodes_offset);
+    auto *tags = reinterpret_cast<tag_type *>(base + h.tags_offset);
+    if (h.header_checksum != header_checksum(h) ||
+        (verify &&
+         h.payload_checksum != payload_checksum(nodes, tags, count))) {
+      errno = EBADMSG;
+      return nullptr;
+    }
+    std::unique_ptr<SegmentTree> tree(new SegmentTree());
+    tree->nodes_ = nodes;
+    tree->tags_ = tags;
+    tree->size_ = static_cast<int64_t>(h.size);
+    tree->mapped_ = std::move(file);
+    return tree;
+  }
 
-  void update_range(int diff, int l, int r);
+  /*
+   * @brief Whether the nodes live in a snapshot mapping
+   */
+  bool mapped() const noexcept {
+    return mapped_ != nullptr;
+  }
+
+  /*
+   * @brief Aggregate of [l, r] as reported by Op, e.g. the sum
+   * @param int64_t l, r
+   * @return result_type, Op::identity() for an empty intersection
+   */
+  result_type query(int64_t l, int64_t r) const {
+    return Op::result(aggregate(l, r));
+  }
+
+  /*
+   * @brief Full node aggregate of [l, r]
+   */
+  value_type aggregate(int64_t l, int64_t r) const {
+    // Clamp first: tags are applied to min(r, qr) - max(l, ql) + 1
+    // elements, which must not go negative for an inverted range
+    l = std::max<int64_t>(l, 0);
+    r = std::min<int64_t>(r, size_ - 1);
+    if (l > r) return Op::identity();
+    return query_range(1, 0, size_ - 1, l, r);
+  }
+
+  /*
+   * @brief Answer queries[i] into out[i]. The nodes a query visits follow
+   *        from its bounds alone, so each query is planned and its nodes
+   *        prefetched kBatchDistance queries ahead of its evaluation, which
+   *        overlaps the cache misses of consecutive queries instead of
+   *        paying them one recursive descent at a time.
+   * @param queries, inclusive [l, r] pairs
+   * @param out, at least queries.size() results
+   */
+  void query_batch(std::span<const std::pair<int, int>> queries,
+                   std::span<result_type> out) const {
+    const size_t count = std::min(queries.size(), out.size());
+    if (count == 0) return;
+    // Path lengths are bounded by the tree height
+    size_t depth = 2;
+    for (auto n = size_; n > 0; n >>= 1) ++depth;
+    std::vector<Step> steps(kBatchDistance * depth * 3);
+    Plan plans[kBatchDistance];
+    for (size_t i = 0; i < kBatchDistance; ++i) {
+      plans[i].steps = steps.data() + i * depth * 3;
+      plans[i].depth = depth;
+    }
+
+    const size_t ahead = std::min(count, kBatchDistance);
+    for (size_t i = 0; i < ahead; ++i) {
+      plan(queries[i].first, queries[i].second, plans[i]);
+    }
+    for (size_t i = 0; i < count; ++i) {
+      Plan &p = plans[i % kBatchDistance];
+      out[i] = Op::result(fold(p));
+      if (i + kBatchDistance < count) {
+        const auto &q = queries[i + kBatchDistance];
+        plan(q.first, q.second, p);
+      }
+    }
+  }
+
+  /*
+   * @brief Same as above, split into chunks of grain queries run through
+   *        executor.parallel_for(begin, end, body(begin, end), grain), e.g.
+   *        an sdk::executor::ThreadPool
+   */
+  template <typename Executor>
+  void query_batch(std::span<const std::pair<int, int>> queries,
+                   std::span<result_type> out, Executor &executor,
+                   size_t grain = 4096) const {
+    const size_t count = std::min(queries.size(), out.size());
+    executor.parallel_for(
+        0, count,
+        [&](size_t begin, size_t end) {
+          query_batch(queries.subspan(begin, end - begin),
+                      out.subspan(begin, end - begin));
+        },
+        grain);
+  }
+
+  T query_min(int64_t l, int64_t r) const {
+    static_assert(std::is_same_v<value_type, RangeStats<T>>,
+                  "query_min needs a StatsOp tree");
+    return aggregate(l, r).min;
+  }
+
+  T query_max(int64_t l, int64_t r) const {
+    static_assert(std::is_same_v<value_type, RangeStats<T>>,
+                  "query_max needs a StatsOp tree");
+    return aggregate(l, r).max;
+  }
+
+  /*
+   * @brief Apply diff to every element of [l, r]
+   */
+  void update_range(tag_type diff, int64_t l, int64_t r) {
+    if (size_ == 0) return;
+    update_range(1, 0, size_ - 1, diff, l, r);
+  }
+
+  /*
+   * @brief Replace element i
+   */
+  template <typename U>
+  void set(int64_t i, const U &x) {
+    if (i < 0 || i >= size_) return;
+    set(1, 0, size_ - 1, i, Op::leaf(x));
+  }
+
+  int64_t size() const noexcept {
+    return size_;
+  }
 
   /*
    * For debug
    */
-  std::vector<int> toArray();
+  std::vector<result_type> toArray() const {
+    std::vector<result_type> res(size_);
+    for (int64_t i = 0; i < size_; ++i) {
+      res[i] = query(i, i);
+    }
+    return res;
+  }
 
  private:
+  // Snapshot file layout, native byte order:
+  //   [0, 4096)             SnapshotHeader, zero padded
+  //   [nodes_offset, ...)   4n value_type, the node aggregates
+  //   [tags_offset, ...)    4n tag_type, the pending tags
+  // Both arrays start on a 4096-byte boundary so the mapping keeps their
+  // alignment. header_checksum covers the header fields before it and is
+  // always checked; payload_checksum covers both arrays and is only
+  // checked by open_mmap(path, true). type_id identifies T, Op and LazyOp,
+  // so a file only opens as the tree type that wrote it.
+  struct SnapshotHeader {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t value_size;
+    uint32_t tag_size;
+    uint32_t reserved;
+    uint64_t byte_order;
+    uint64_t size;
+    uint64_t node_count;
+    uint64_t nodes_offset;
+    uint64_t tags_offset;
+    uint64_t file_size;
+    uint64_t type_id;
+    uint64_t payload_checksum;
+    uint64_t header_checksum;
+  };
+
+  static constexpr uint32_t kSnapshotVersion = 2;
+  static constexpr uint64_t kSnapshotAlign = 4096;
+
+  // Mapped trees are filled in by open_mmap()
+  SegmentTree() : size_(0) {}
+
+  static uint64_t align_up(uint64_t x) {
+    return (x + kSnapshotAlign - 1) & ~(kSnapshotAlign - 1);
+  }
+
+  // Header of a snapshot of count nodes, checksums left to fill
+  static SnapshotHeader header(uint64_t count) {
+    SnapshotHeader h{};
+    std::memcpy(h.magic, "SDKSEGTR", sizeof(h.magic));
+    h.format_version = kSnapshotVersion;
+    h.value_size = sizeof(value_type);
+    h.tag_size = sizeof(tag_type);
+    h.byte_order = 0x0102030405060708ULL;
+    h.size = count / 4;
+    h.node_count = count;
+    h.nodes_offset = kSnapshotAlign;
+    h.tags_offset = align_up(h.nodes_offset + count * sizeof(value_type));
+    h.file_size = h.tags_offset + count * sizeof(tag_type);
+    h.type_id = type_id();
+    return h;
+  }
+
+  // FNV-1a of this instantiation's name as the compiler spells it, e.g.
+  // "... [T = long, Op = sdk::container::SumOp<long>, ...]". Stable across
+  // builds of one compiler; a file from another compiler is rejected with
+  // EINVAL rather than misread.
+  static uint64_t type_id() noexcept {
+    const std::string_view name = __PRETTY_FUNCTION__;
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (const char c : name) {
+      h ^= static_cast<unsigned char>(c);
+      h *= 0x100000001b3ULL;
+    }
+    return h;
+  }
+
+  static uint64_t header_checksum(const SnapshotHeader &h) {
+    return checksum64(&h, offsetof(SnapshotHeader, header_checksum));
+  }
+
+  static uint64_t payload_checksum(const value_type *nodes,
+                                   const tag_type *tags, uint64_t count) {
+    return checksum64(tags, count * sizeof(tag_type),
+                      checksum64(nodes, count * sizeof(value_type)));
+  }
+
+  size_t node_count() const noexcept {
+    return static_cast<size_t>(size_) * 4;
+  }
+
+  // Queries planned ahead by query_batch()
+  static constexpr size_t kBatchDistance = 8;
+
+  // A node on a query path whose tag covers len elements of the query, and
+  // the fully covered child taken next to it if any
+  struct Step {
+    int64_t node;
+    int64_t sibling;
+    int64_t len;
+  };
+
+  // The recursive descent of one query flattened. top is the path above
+  // and including the split node, left/right the boundary paths below it,
+  // all stored top-down in steps[0, depth), [depth, 2 depth), [2 depth, ..)
+  struct Plan {
+    Step *steps = nullptr;
+    size_t depth = 0;
+    size_t n_top = 0, n_left = 0, n_right = 0;
+    int64_t left_end = 0, right_end = 0; // covered nodes ending each path
+    bool empty = true, split = false;
+  };
+
+  void plan(int64_t ql, int64_t qr, Plan &p) const {
+    p.n_top = p.n_left = p.n_right = 0;
+    ql = std::max<int64_t>(ql, 0);
+    qr = std::min<int64_t>(qr, size_ - 1);
+    p.empty = ql > qr;
+    if (p.empty) return;
+
+    Step *top = p.steps;
+    Step *left = p.steps + p.depth;
+    Step *right = p.steps + p.depth * 2;
+    auto visit = [&](Step *path, size_t &n, int64_t node, int64_t sibling,
+                     int64_t l, int64_t r) {
+      path[n++] = {node, sibling, std::min(r, qr) - std::max(l, ql) + 1};
+      __builtin_prefetch(&tags_[node]);
+      if (sibling != 0) __builtin_prefetch(&nodes_[sibling]);
+    };
+
+    int64_t node = 1, l = 0, r = size_ - 1;
+    p.split = false;
+    while (l < ql || r > qr) {
+      auto mid = l + ((r - l) >> 1);
+      visit(top, p.n_top, node, 0, l, r);
+      if (qr <= mid) {
+        node = node * 2;
+        r = mid;
+      } else if (ql > mid) {
+        node = node * 2 + 1;
+        l = mid + 1;
+      } else {
+        p.split = true;
+        break;
+      }
+    }
+    if (!p.split) {
+      p.left_end = node;
+      __builtin_prefetch(&nodes_[node]);
+      return;
+    }
+
+    // Left boundary: every node ends at or before qr
+    const auto split_mid = l + ((r - l) >> 1);
+    int64_t n = node * 2, nl = l, nr = split_mid;
+    while (nl < ql) {
+      auto mid = nl + ((nr - nl) >> 1);
+      if (ql > mid) {
+        visit(left, p.n_left, n, 0, nl, nr);
+        n = n * 2 + 1;
+        nl = mid + 1;
+      } else {
+        visit(left, p.n_left, n, n * 2 + 1, nl, nr);
+        n = n * 2;
+        nr = mid;
+      }
+    }
+    p.left_end = n;
+    __builtin_prefetch(&nodes_[n]);
+
+    // Right boundary: every node starts at or after ql
+    n = node * 2 + 1, nl = split_mid + 1, nr = r;
+    while (nr > qr) {
+      auto mid = nl + ((nr - nl) >> 1);
+      if (qr <= mid) {
+        visit(right, p.n_right, n, 0, nl, nr);
+        n = n * 2;
+        nr = mid;
+      } else {
+        visit(right, p.n_right, n, n * 2, nl, nr);
+        n = n * 2 + 1;
+        nl = mid + 1;
+      }
+    }
+    p.right_end = n;
+    __builtin_prefetch(&nodes_[n]);
+  }
+
+  // Evaluate a plan bottom-up, the same combines and tags as query_range()
+  value_type fold(const Plan &p) const {
+    if (p.empty) return Op::identity();
+    auto tag = [this](value_type &v, const Step &s) {
+      if (!(tags_[s.node] == LazyOp::identity())) {
+        LazyOp::apply(v, tags_[s.node], static_cast<size_t>(s.len));
+      }
+    };
+    value_type res = nodes_[p.left_end];
+    if (p.split) {
+      const Step *left = p.steps + p.depth;
+      for (size_t i = p.n_left; i-- > 0;) {
+        if (left[i].sibling != 0) {
+          res = Op::combine(res, nodes_[left[i].sibling]);
+        }
+        tag(res, left[i]);
+      }
+      const Step *right = p.steps + p.depth * 2;
+      value_type res_r = nodes_[p.right_end];
+      for (size_t i = p.n_right; i-- > 0;) {
+        if (right[i].sibling != 0) {
+          res_r = Op::combine(nodes_[right[i].sibling], res_r);
+        }
+        tag(res_r, right[i]);
+      }
+      res = Op::combine(res, res_r);
+    }
+    for (size_t i = p.n_top; i-- > 0;) {
+      tag(res, p.steps[i]);
+    }
+    return res;
+  }
+
   /*
    * @brief Build segment tree recursively
-   * @param const std::vector<int> &data
-   * @param int node
-   * @param int start, end
+   * @param const std::vector<U> &data
+   * @param int64_t node
+   * @param int64_t start, end
    */
-  void build(const std::vector<int> &data, int node, int start, int end);
+  template <typename U>
+  void build(const std::vector<U> &data, int64_t node, int64_t start,
+             int64_t end) {
+    if (start == end /*叶子节点*/) {
+      nodes_[node] = Op::leaf(data[start]);
+      return;
+    }
+    auto mid = start + ((end - start) >> 1);
+    build(data, node * 2, start, mid);
+    build(data, node * 2 + 1, mid + 1, end);
+    nodes_[node] = Op::combine(nodes_[node * 2], nodes_[node * 2 + 1]);
+  }
 
   /*
-   * @brief Get sum of [l, r]
-   * @param int node, node is index of tree
-   * @param int start, end
-   * @param int l, r
-   * @return int
+   * @brief Get the aggregate of [ql, qr] within node's range [l, r]. Pending
+   *        tags are applied to the partial result on the way up instead of
+   *        being pushed down, so the tree is not modified.
+   * @return value_type
    */
-  int query_range(int node, int l, int r, int ql, int qr);
+  value_type query_range(int64_t node, int64_t l, int64_t r, int64_t ql,
+                         int64_t qr) const {
+    // 无交集
+    if (l > qr || r < ql) {
+      return Op::identity();
+    }
+
+    // 区间内
+    if (l >= ql && r <= qr) {
+      return nodes_[node];
+    }
+
+    // 区间合并
+    auto mid = l + ((r - l) >> 1);
+    value_type res = Op::combine(query_range(node * 2, l, mid, ql, qr),
+                                 query_range(node * 2 + 1, mid + 1, r, ql, qr));
+    if (!(tags_[node] == LazyOp::identity())) {
+      const auto len = std::min(r, qr) - std::max(l, ql) + 1;
+      LazyOp::apply(res, tags_[node], static_cast<size_t>(len));
+    }
+    return res;
+  }
 
   /*
-   * @brief Update diff of [l, r]
-   * @param int node, node is index of tree
-   * @param int start, end, current node range
-   * @param int diff
-   * @param int l, r
-   * @return void
+   * @brief Update diff of [ql, qr]
+   * @param int64_t node, node is index of tree
+   * @param int64_t l, r, current node range
    */
-  void update_range(int node, int l, int r, int diff, int ql, int qr);
+  void update_range(int64_t node, int64_t l, int64_t r, tag_type diff,
+                    int64_t ql, int64_t qr) {
+    // 当前节点与更新区间无交集，直接返回
+    if (qr < l || ql > r) {
+      return;
+    }
+
+    // 一个区间内
+    if (l >= ql && r <= qr) {
+      apply(node, diff, r - l + 1);
+      return;
+    }
 
-  void push_down(int node, int l, int r);
+    // 两个区间，向下传递标记，再回溯
+    push_down(node, l, r);
+    auto mid = l + ((r - l) >> 1);
+    update_range(node * 2, l, mid, diff, ql, qr);
+    update_range(node * 2 + 1, mid + 1, r, diff, ql, qr);
+    nodes_[node] = Op::combine(nodes_[node * 2], nodes_[node * 2 + 1]);
+  }
+
+  void set(int64_t node, int64_t l, int64_t r, int64_t i,
+           const value_type &v) {
+    if (l == r) {
+      nodes_[node] = v;
+      tags_[node] = LazyOp::identity();
+      return;
+    }
+    push_down(node, l, r);
+    auto mid = l + ((r - l) >> 1);
+    if (i <= mid) {
+      set(node * 2, l, mid, i, v);
+    } else {
+      set(node * 2 + 1, mid + 1, r, i, v);
+    }
+    nodes_[node] = Op::combine(nodes_[node * 2], nodes_[node * 2 + 1]);
+  }
+
+  // Tag a node: its aggregate is updated now, its children later
+  void apply(int64_t node, const tag_type &tag, int64_t len) {
+    LazyOp::apply(nodes_[node], tag, static_cast<size_t>(len));
+    tags_[node] = LazyOp::compose(tags_[node], tag);
+  }
+
+  void push_down(int64_t node, int64_t l, int64_t r) {
+    if (!(tags_[node] == LazyOp::identity())) {
+      auto mid = l + ((r - l) >> 1);
+      apply(node * 2, tags_[node], mid - l + 1);
+      apply(node * 2 + 1, tags_[node], r - mid);
+      tags_[node] = LazyOp::identity();
+    }
+  }
+
+  std::vector<value_type> tree_;
+  std::vector<tag_type> lazy_;
+  // The node arrays in use: tree_/lazy_, or the snapshot in mapped_
+  value_type *nodes_ = nullptr;
+  tag_type *tags_ = nullptr;
+  std::unique_ptr<MappedFile> mapped_;
+  int64_t size_;
 };
 
+// The sum tree is instantiated once in segment_tree.cc
+extern template class SegmentTree<int64_t>;
+
 } // namespace container
 } // namespace sdk
@@ -0,0 +1,230 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file sequenced_ring.hpp
+ * @brief The bounded ring and producer side shared by the MPSC and MPMC
+ *        queues.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "container/wait_strategy.hpp"
+#include "macro/macros.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace sdk {
+namespace container {
+
+// Bounded lock-free ring with many producers (Vyukov style), the base of
+// MPSCQueue and MPMCQueue
+//
+// Every cell carries a sequence number:
+//   seq == pos            cell is free for the producer claiming pos
+//   seq == pos + 1        cell holds the element written at pos
+//   seq == pos + capacity cell was consumed, free for the next lap
+// Producers claim a position with a CAS on head_. The consumer side, pop()
+// on tail_, is up to the queue: it moves the element out, destroys it and
+// hands the cell on with seq = pos + capacity. Cells are aligned to
+// CellAlign, a cache line keeps neighbouring consumers apart. Capacity is
+// rounded up to a power of two.
+template <typename T, typename Wait, size_t CellAlign>
+class SequencedRing {
+ public:
+  DISALLOW_COPY_AND_MOVE(SequencedRing);
+
+  bool try_push(const T &value) noexcept(
+      std::is_nothrow_copy_constructible_v<T>) {
+    return emplace(value);
+  }
+
+  bool try_push(T &&value) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    return emplace(std::move(value));
+  }
+
+  bool push(const T &value, int max_attempt) noexcept(
+      std::is_nothrow_copy_constructible_v<T>) {
+    for (auto i = 0; i < max_attempt; ++i) {
+      if (try_push(value)) {
+        return true;
+      }
+      std::this_thread::yield();
+    }
+    return false;
+  }
+
+  bool push(T &&value,
+            int max_attempt) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    for (auto i = 0; i < max_attempt; ++i) {
+      if (try_push(std::move(value))) {
+        return true;
+      }
+      std::this_thread::yield();
+    }
+    return false;
+  }
+
+  /*
+   * @brief Construct an element in place, safe to call from many producers.
+   *        A constructor that may throw runs on a temporary before a cell
+   *        is claimed, so an exception leaves the queue untouched.
+   * @return bool, false when full
+   */
+  template <typename... Args>
+  bool emplace(Args &&...args) noexcept(
+      std::is_nothrow_constructible_v<T, Args...>) {
+    if constexpr (!std::is_nothrow_constructible_v<T, Args...>) {
+      // A claimed cell must always be published, or consumers stall
+      static_assert(std::is_nothrow_move_constructible_v<T>,
+                    "T must be nothrow move constructible");
+      return emplace(T(std::forward<Args>(args)...));
+    }
+    size_t pos = head_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell &cell = cells_[pos & mask_];
+      const size_t seq = cell.seq.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        // Cell is free for this lap, try to claim pos
+        if (head_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          ::new (static_cast<void *>(cell.ptr()))
+              T(std::forward<Args>(args)...);
+          cell.seq.store(pos + 1, std::memory_order_release);
+          not_empty_.notify();
+          return true;
+        }
+      } else if (diff < 0) {
+        // Cell still holds the element from the previous lap: full
+        return false;
+      } else {
+        // Another producer claimed pos, reload
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /*
+   * @brief Push, blocking with the Wait strategy while the queue is full
+   * @return bool, false when still full after timeout
+   */
+  template <class Rep, class Period>
+  bool push_wait(const T &value, std::chrono::duration<Rep, Period> timeout) {
+    if (try_push(value)) {
+      return true;
+    }
+    const auto deadline = deadline_after(timeout);
+    while (not_full_.wait_until([this] { return !full(); }, deadline)) {
+      if (try_push(value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <class Rep, class Period>
+  bool push_wait(T &&value, std::chrono::duration<Rep, Period> timeout) {
+    if (try_push(std::move(value))) {
+      return true;
+    }
+    const auto deadline = deadline_after(timeout);
+    while (not_full_.wait_until([this] { return !full(); }, deadline)) {
+      if (try_push(std::move(value))) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Approximate when producers or consumers are running
+  size_t size() const noexcept {
+    const size_t t = tail_.load(std::memory_order_acquire);
+    const size_t h = head_.load(std::memory_order_acquire);
+    return h > t ? h - t : 0;
+  }
+
+  bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  bool full() const noexcept {
+    return size() >= capacity_;
+  }
+
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+ protected:
+  struct alignas(CellAlign) alignas(std::atomic<size_t>) alignas(T) Cell {
+    std::atomic<size_t> seq;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T *ptr() noexcept {
+      return std::launder(reinterpret_cast<T *>(storage));
+    }
+  };
+
+  explicit SequencedRing(size_t size)
+      : capacity_(round_up(size)), mask_(capacity_ - 1),
+        cells_(new Cell[capacity_]), head_(0), tail_(0) {
+    for (size_t i = 0; i < capacity_; ++i) {
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~SequencedRing() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      size_t pos = tail_.load(std::memory_order_relaxed);
+      while (true) {
+        Cell &cell = cells_[pos & mask_];
+        if (cell.seq.load(std::memory_order_acquire) != pos + 1) break;
+        std::destroy_at(cell.ptr());
+        ++pos;
+      }
+    }
+    delete[] cells_;
+  }
+
+  static size_t round_up(size_t n) noexcept {
+    size_t cap = 2;
+    while (cap < n) cap <<= 1;
+    return cap;
+  }
+
+  // Move the element at pos out of cell and hand the cell to the producer
+  // of the next lap
+  template <typename U>
+  void take(Cell &cell, size_t pos, U &&out) {
+    out = std::move(*cell.ptr());
+    std::destroy_at(cell.ptr());
+    cell.seq.store(pos + capacity_, std::memory_order_release);
+  }
+
+  const size_t capacity_;
+  const size_t mask_;
+  Cell *cells_;
+  // Claimed by producers
+  alignas(64) std::atomic<size_t> head_;
+  // Advanced by the consumer side
+  alignas(64) std::atomic<size_t> tail_;
+  // Consumers wait on not_empty_, producers wait on not_full_
+  alignas(64) Wait not_empty_;
+  Wait not_full_;
+};
+
+} // namespace container
+} // namespace sdk
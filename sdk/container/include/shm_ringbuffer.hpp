@@ -0,0 +1,323 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file shm_ringbuffer.hpp
+ * @brief A SPSC ring buffer living in shared memory between two processes.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "container/shm_segment.h"
+#include "macro/macros.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <signal.h>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
+
+namespace sdk {
+namespace container {
+
+enum class ShmRole {
+  kProducer,
+  kConsumer,
+};
+
+constexpr uint64_t kShmRingMagic = 0x21474e49524b4453ULL; // "SDKRING!"
+constexpr uint32_t kShmRingVersion = 1;
+
+// Control block at offset 0 of the segment, slots follow at data_offset.
+// Bump kShmRingVersion whenever this layout changes.
+struct ShmRingHeader {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t elem_size;
+  uint32_t elem_align;
+  uint32_t data_offset;
+  uint64_t capacity;
+  std::atomic<uint32_t> ready;
+  // Producer line: published write counter and owner pid (0 = detached)
+  alignas(64) std::atomic<uint64_t> head;
+  std::atomic<int32_t> producer_pid;
+  // Consumer line: published read counter and owner pid (0 = detached)
+  alignas(64) std::atomic<uint64_t> tail;
+  std::atomic<int32_t> consumer_pid;
+};
+
+static_assert(std::is_standard_layout_v<ShmRingHeader>);
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "shared memory counters must be lock-free");
+
+// Cross-process SPSC ring buffer: control block and slots live in a
+// shm_open or memfd segment, so the hot path is plain loads and stores with
+// no syscalls. Counters are free-running, capacity is a power of two.
+//
+// One process creates the ring (Create/CreateAnonymous) and the other
+// attaches (Attach/AttachFd), each taking the producer or consumer role.
+// A role is owned by one live process at a time; if the previous owner died
+// the role can be taken over and the ring resumes from the shared counters.
+// peer_alive() reports whether the other side is attached and running.
+//
+// T must be trivially copyable since its bytes are shared between address
+// spaces.
+template <typename T>
+class ShmSPSCRingbuffer {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "T must be trivially copyable to live in shared memory");
+
+ public:
+  ~ShmSPSCRingbuffer() {
+    if (header_) {
+      int32_t self = static_cast<int32_t>(::getpid());
+      own_pid().compare_exchange_strong(self, 0, std::memory_order_acq_rel);
+    }
+  }
+
+  DISALLOW_COPY_AND_MOVE(ShmSPSCRingbuffer);
+
+  /*
+   * @brief Create a named ring, fails with EEXIST if the name is taken
+   * @return std::unique_ptr<ShmSPSCRingbuffer>, nullptr on failure
+   */
+  static std::unique_ptr<ShmSPSCRingbuffer> Create(const std::string &name,
+                                                   size_t capacity,
+                                                   ShmRole role) {
+    const size_t cap = round_up(capacity);
+    auto seg = ShmSegment::Create(name, data_offset() + cap * sizeof(T));
+    if (!seg) return nullptr;
+    return Init(std::move(seg), cap, role);
+  }
+
+  /*
+   * @brief Create a ring on an anonymous memfd, share fd() with the peer
+   * @return std::unique_ptr<ShmSPSCRingbuffer>, nullptr on failure
+   */
+  static std::unique_ptr<ShmSPSCRingbuffer> CreateAnonymous(size_t capacity,
+                                                            ShmRole role) {
+    const size_t cap = round_up(capacity);
+    auto seg = ShmSegment::CreateAnonymous(data_offset() + cap * sizeof(T));
+    if (!seg) return nullptr;
+    return Init(std::move(seg), cap, role);
+  }
+
+  /*
+   * @brief Attach to a named ring created by another process
+   * @return std::unique_ptr<ShmSPSCRingbuffer>, nullptr on failure: EPROTO
+   *         for a header/version/type mismatch, EBUSY if the role is owned
+   *         by a live process
+   */
+  static std::unique_ptr<ShmSPSCRingbuffer> Attach(const std::string &name,
+                                                   ShmRole role) {
+    auto seg = ShmSegment::Open(name);
+    if (!seg) return nullptr;
+    return Validate(std::move(seg), role);
+  }
+
+  static std::unique_ptr<ShmSPSCRingbuffer> AttachFd(int fd, ShmRole role) {
+    auto seg = ShmSegment::FromFd(fd);
+    if (!seg) return nullptr;
+    return Validate(std::move(seg), role);
+  }
+
+  bool try_push(const T &value) noexcept {
+    T *slot = reserve();
+    if (!slot) {
+      return false;
+    }
+    *slot = value;
+    commit();
+    return true;
+  }
+
+  bool push(const T &value, int max_attempt) noexcept {
+    for (auto i = 0; i < max_attempt; ++i) {
+      if (try_push(value)) {
+        return true;
+      }
+      std::this_thread::yield();
+    }
+    return false;
+  }
+
+  bool pop(T &value) noexcept {
+    const T *slot = front();
+    if (!slot) {
+      return false;
+    }
+    value = *slot;
+    release();
+    return true;
+  }
+
+  /*
+   * @brief Producer: next free slot to write in place, publish with commit()
+   * @return T*, nullptr when full
+   */
+  T *reserve() noexcept {
+    if (head_ - tail_cache_ == capacity_) {
+      tail_cache_ = header_->tail.load(std::memory_order_acquire);
+      if (head_ - tail_cache_ == capacity_) {
+        return nullptr;
+      }
+    }
+    return data_ + (head_ & mask_);
+  }
+
+  void commit() noexcept {
+    header_->head.store(++head_, std::memory_order_release);
+  }
+
+  /*
+   * @brief Consumer: oldest element to read in place, drop with release()
+   * @return const T*, nullptr when empty
+   */
+  const T *front() noexcept {
+    if (tail_ == head_cache_) {
+      head_cache_ = header_->head.load(std::memory_order_acquire);
+      if (tail_ == head_cache_) {
+        return nullptr;
+      }
+    }
+    return data_ + (tail_ & mask_);
+  }
+
+  void release() noexcept {
+    header_->tail.store(++tail_, std::memory_order_release);
+  }
+
+  /*
+   * @brief Whether the other role is attached by a running process
+   */
+  bool peer_alive() const noexcept {
+    const int32_t pid = peer_pid().load(std::memory_order_acquire);
+    return pid != 0 && process_alive(pid);
+  }
+
+  size_t size() const noexcept {
+    const uint64_t t = header_->tail.load(std::memory_order_acquire);
+    const uint64_t h = header_->head.load(std::memory_order_acquire);
+    return static_cast<size_t>(h - t);
+  }
+
+  bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  // memfd/shm file descriptor, pass it to the peer for AttachFd
+  int fd() const noexcept {
+    return seg_->fd();
+  }
+
+ private:
+  ShmSPSCRingbuffer(std::unique_ptr<ShmSegment> seg, ShmRole role)
+      : seg_(std::move(seg)),
+        header_(static_cast<ShmRingHeader *>(seg_->data())),
+        data_(reinterpret_cast<T *>(static_cast<uint8_t *>(seg_->data()) +
+                                    header_->data_offset)),
+        role_(role), capacity_(header_->capacity), mask_(capacity_ - 1),
+        head_(header_->head.load(std::memory_order_acquire)),
+        tail_cache_(header_->tail.load(std::memory_order_acquire)),
+        tail_(tail_cache_), head_cache_(head_) {}
+
+  static constexpr size_t data_offset() noexcept {
+    constexpr size_t kAlign = alignof(T) > 64 ? alignof(T) : 64;
+    return (sizeof(ShmRingHeader) + kAlign - 1) / kAlign * kAlign;
+  }
+
+  static size_t round_up(size_t n) noexcept {
+    size_t cap = 2;
+    while (cap < n) cap <<= 1;
+    return cap;
+  }
+
+  static bool process_alive(int32_t pid) noexcept {
+    return ::kill(pid, 0) == 0 || errno == EPERM;
+  }
+
+  static std::unique_ptr<ShmSPSCRingbuffer> Init(
+      std::unique_ptr<ShmSegment> seg, size_t cap, ShmRole role) {
+    auto *h = ::new (seg->data()) ShmRingHeader{};
+    h->magic = kShmRingMagic;
+    h->version = kShmRingVersion;
+    h->elem_size = sizeof(T);
+    h->elem_align = alignof(T);
+    h->data_offset = static_cast<uint32_t>(data_offset());
+    h->capacity = cap;
+    (role == ShmRole::kProducer ? h->producer_pid : h->consumer_pid)
+        .store(static_cast<int32_t>(::getpid()), std::memory_order_relaxed);
+    // Everything above becomes visible to an attacher that sees ready == 1
+    h->ready.store(1, std::memory_order_release);
+    return std::unique_ptr<ShmSPSCRingbuffer>(
+        new ShmSPSCRingbuffer(std::move(seg), role));
+  }
+
+  static std::unique_ptr<ShmSPSCRingbuffer> Validate(
+      std::unique_ptr<ShmSegment> seg, ShmRole role) {
+    auto *h = static_cast<ShmRingHeader *>(seg->data());
+    if (seg->size() < sizeof(ShmRingHeader) ||
+        h->ready.load(std::memory_order_acquire) != 1 ||
+        h->magic != kShmRingMagic || h->version != kShmRingVersion ||
+        h->elem_size != sizeof(T) || h->elem_align != alignof(T) ||
+        h->data_offset != data_offset() || h->capacity < 2 ||
+        (h->capacity & (h->capacity - 1)) != 0 ||
+        seg->size() < data_offset() + h->capacity * sizeof(T)) {
+      errno = EPROTO;
+      return nullptr;
+    }
+
+    // Take the role unless a live process owns it
+    auto &slot =
+        role == ShmRole::kProducer ? h->producer_pid : h->consumer_pid;
+    const auto self = static_cast<int32_t>(::getpid());
+    int32_t owner = slot.load(std::memory_order_acquire);
+    do {
+      if (owner != 0 && owner != self && process_alive(owner)) {
+        errno = EBUSY;
+        return nullptr;
+      }
+    } while (!slot.compare_exchange_weak(owner, self,
+                                         std::memory_order_acq_rel));
+    return std::unique_ptr<ShmSPSCRingbuffer>(
+        new ShmSPSCRingbuffer(std::move(seg), role));
+  }
+
+  std::atomic<int32_t> &own_pid() const noexcept {
+    return role_ == ShmRole::kProducer ? header_->producer_pid
+                                       : header_->consumer_pid;
+  }
+
+  std::atomic<int32_t> &peer_pid() const noexcept {
+    return role_ == ShmRole::kProducer ? header_->consumer_pid
+                                       : header_->producer_pid;
+  }
+
+  std::unique_ptr<ShmSegment> seg_;
+  ShmRingHeader *const header_;
+  T *const data_;
+  const ShmRole role_;
+  const uint64_t capacity_;
+  const uint64_t mask_;
+  // Process-local copies, only the owning role touches its pair
+  alignas(64) uint64_t head_;
+  uint64_t tail_cache_;
+  alignas(64) uint64_t tail_;
+  uint64_t head_cache_;
+};
+
+} // namespace container
+} // namespace sdk
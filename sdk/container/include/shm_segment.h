@@ -0,0 +1,86 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file shm_segment.h
+ * @brief A shared memory segment (shm_open or memfd) mapped read-write.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "macro/macros.h"
+
+#include <cstddef>
+
+#include <memory>
+#include <string>
+
+namespace sdk {
+namespace container {
+
+class ShmSegment {
+ public:
+  ~ShmSegment();
+
+  /*
+   * @brief Create a named POSIX shared memory object, fails if it exists
+   * @param const std::string &name, e.g. "/feed_ring"
+   * @param size_t size
+   * @return std::unique_ptr<ShmSegment>, nullptr on failure (errno is set)
+   */
+  static std::unique_ptr<ShmSegment> Create(const std::string &name,
+                                            size_t size);
+
+  /*
+   * @brief Open and map an existing named shared memory object
+   * @return std::unique_ptr<ShmSegment>, nullptr on failure (errno is set)
+   */
+  static std::unique_ptr<ShmSegment> Open(const std::string &name);
+
+  /*
+   * @brief Create an anonymous memfd segment, share it with another process
+   *        by fork() or by passing fd() over a unix socket
+   * @return std::unique_ptr<ShmSegment>, nullptr on failure (errno is set)
+   */
+  static std::unique_ptr<ShmSegment> CreateAnonymous(size_t size);
+
+  /*
+   * @brief Map a segment from a file descriptor, the fd is duplicated
+   * @return std::unique_ptr<ShmSegment>, nullptr on failure (errno is set)
+   */
+  static std::unique_ptr<ShmSegment> FromFd(int fd);
+
+  /*
+   * @brief Remove a named shared memory object, mappings stay valid
+   */
+  static bool Unlink(const std::string &name);
+
+  void *data() const {
+    return data_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  int fd() const {
+    return fd_;
+  }
+
+ private:
+  ShmSegment(int fd, void *data, size_t size);
+
+  // Size fd to size (if non zero) and map it, closes fd on failure
+  static std::unique_ptr<ShmSegment> Map(int fd, size_t size);
+
+  int fd_;
+  void *data_;
+  size_t size_;
+
+  DISALLOW_COPY_AND_MOVE(ShmSegment);
+};
+
+} // namespace container
+} // namespace sdk
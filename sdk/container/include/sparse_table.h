@@ -0,0 +1,167 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file sparse_table.h
+ * @brief O(1) range min/max over a read-only array.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "container/segment_tree.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace sdk {
+namespace container {
+
+// Static range queries for idempotent ops (combine(a, a) == a): MinOp,
+// MaxOp from segment_tree.h, or gcd, and, or. The array cannot change
+// after construction. All indices are inclusive [l, r] and clipped to the
+// array, an empty range gives Op::identity().
+
+// Sparse table: level k holds the aggregate of every 2^k elements, a query
+// combines the two overlapping power-of-two windows covering [l, r].
+// O(1) query, n * log2(n) values of memory.
+template <typename T = int64_t, typename Op = MinOp<T>>
+class SparseTable {
+ public:
+  using value_type = typename Op::value_type;
+
+  SparseTable() = default;
+
+  template <typename U>
+  explicit SparseTable(const std::vector<U> &data) {
+    const size_t n = data.size();
+    if (n == 0) return;
+    levels_.emplace_back(n);
+    for (size_t i = 0; i < n; ++i) levels_[0][i] = Op::leaf(data[i]);
+    for (size_t width = 1; width * 2 <= n; width *= 2) {
+      const auto &prev = levels_.back();
+      std::vector<value_type> level(n - width * 2 + 1);
+      for (size_t i = 0; i < level.size(); ++i) {
+        level[i] = Op::combine(prev[i], prev[i + width]);
+      }
+      levels_.push_back(std::move(level));
+    }
+  }
+
+  value_type query(int64_t l, int64_t r) const noexcept {
+    l = std::max<int64_t>(l, 0);
+    r = std::min<int64_t>(r, size() - 1);
+    if (l > r) return Op::identity();
+    const auto len = static_cast<uint64_t>(r - l + 1);
+    const int k = 63 - __builtin_clzll(len);
+    const auto &level = levels_[k];
+    return Op::combine(level[l], level[r - (int64_t{1} << k) + 1]);
+  }
+
+  int64_t size() const noexcept {
+    return levels_.empty() ? 0 : static_cast<int64_t>(levels_[0].size());
+  }
+
+  size_t memory_usage() const noexcept {
+    size_t bytes = 0;
+    for (const auto &level : levels_) {
+      bytes += level.size() * sizeof(value_type);
+    }
+    return bytes;
+  }
+
+ private:
+  std::vector<std::vector<value_type>> levels_;
+};
+
+// Block-decomposed sparse table with O(n) memory and O(1) query
+//
+// The array is cut into blocks of BlockSize elements. A sparse table over
+// the block aggregates answers the whole blocks of a query, per-element
+// prefix/suffix aggregates inside each block answer its two ends, and a
+// query inside a single block scans the elements, a short loop over
+// contiguous values that the compiler vectorizes.
+//
+// Memory is 3n values plus (n / BlockSize) * log2(n / BlockSize).
+template <typename T = int64_t, typename Op = MinOp<T>,
+          size_t BlockSize = 32>
+class BlockSparseTable {
+ public:
+  using value_type = typename Op::value_type;
+
+  static_assert((BlockSize & (BlockSize - 1)) == 0,
+                "BlockSize must be a power of two");
+
+  template <typename U>
+  explicit BlockSparseTable(const std::vector<U> &data)
+      : values_(data.size()), prefix_(data.size()), suffix_(data.size()) {
+    const size_t n = data.size();
+    for (size_t i = 0; i < n; ++i) values_[i] = Op::leaf(data[i]);
+
+    std::vector<value_type> blocks((n + BlockSize - 1) / BlockSize);
+    for (size_t b = 0; b < blocks.size(); ++b) {
+      const size_t begin = b * BlockSize;
+      const size_t end = std::min(begin + BlockSize, n);
+      value_type acc = values_[begin];
+      for (size_t i = begin; i < end; ++i) {
+        acc = Op::combine(acc, values_[i]);
+        prefix_[i] = acc;
+      }
+      blocks[b] = acc;
+      acc = values_[end - 1];
+      for (size_t i = end; i-- > begin;) {
+        acc = Op::combine(values_[i], acc);
+        suffix_[i] = acc;
+      }
+    }
+    table_ = SparseTable<value_type, IdentityOp>(blocks);
+  }
+
+  value_type query(int64_t l, int64_t r) const noexcept {
+    l = std::max<int64_t>(l, 0);
+    r = std::min<int64_t>(r, size() - 1);
+    if (l > r) return Op::identity();
+    const int64_t bl = l / static_cast<int64_t>(BlockSize);
+    const int64_t br = r / static_cast<int64_t>(BlockSize);
+    if (bl == br) return scan(l, r);
+    value_type res = Op::combine(suffix_[l], prefix_[r]);
+    if (br - bl > 1) res = Op::combine(res, table_.query(bl + 1, br - 1));
+    return res;
+  }
+
+  int64_t size() const noexcept {
+    return static_cast<int64_t>(values_.size());
+  }
+
+  size_t memory_usage() const noexcept {
+    return values_.size() * 3 * sizeof(value_type) + table_.memory_usage();
+  }
+
+ private:
+  // The block table is built from aggregates that are already value_type
+  struct IdentityOp : Op {
+    static value_type leaf(const value_type &v) noexcept {
+      return v;
+    }
+  };
+
+  value_type scan(int64_t l, int64_t r) const noexcept {
+    const value_type *p = values_.data();
+    value_type acc = p[l];
+    for (int64_t i = l + 1; i <= r; ++i) acc = Op::combine(acc, p[i]);
+    return acc;
+  }
+
+  std::vector<value_type> values_;
+  std::vector<value_type> prefix_;
+  std::vector<value_type> suffix_;
+  SparseTable<value_type, IdentityOp> table_;
+};
+
+} // namespace container
+} // namespace sdk
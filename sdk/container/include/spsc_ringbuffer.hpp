@@ -10,11 +10,16 @@
 
 #pragma once
 
+#include "container/wait_strategy.hpp"
 #include "macro/macros.h"
 
+#include <chrono>
 #include <cstddef>
 
+#include <algorithm>
 #include <atomic>
+#include <memory>
+#include <new>
 #include <thread>
 #include <type_traits>
 #include <utility>
@@ -23,53 +28,81 @@ namespace sdk {
 namespace container {
 
 // Thread-safe SPSC ring buffer (single-producer single-consumer)
-// Notes: Do not supports placement new for data_ now
-// TODO: support placement new for data_
-//       (requires T to be default-constructible)
-template <typename T, bool placement_new = false>
+//
+// placement_new = false: data_ is allocated with new T[size_], T must be
+//   default-constructible and elements are assigned in and out of live slots.
+// placement_new = true: data_ is raw storage, elements are constructed in
+//   place on push/emplace and destroyed on pop/release, so T only needs to be
+//   move- or copy-constructible.
+//
+// Zero-copy usage:
+//   producer: T *slot = rb.reserve(); write *slot; rb.commit();
+//   consumer: T *slot = rb.front(); read *slot; rb.release();
+//
+// Wait decides how push_wait/pop_wait block, see wait_strategy.hpp:
+// BusySpinWait, SpinYieldWait<> (default) or FutexWait<> which parks an idle
+// side and is woken by the next publish.
+template <typename T, bool placement_new = false,
+          typename Wait = SpinYieldWait<>>
 class SPSCRingbuffer {
  public:
   explicit SPSCRingbuffer(size_t size) noexcept
-      : size_(size), data_(nullptr), head_(0), tail_(0) {
+      : size_(size), data_(nullptr), head_(0), tail_cache_(0), tail_(0),
+        head_cache_(0) {
     // size at least 2 to avoid head == tail ambiguity
     size_ = (size_ < 2) ? 2 : size_;
-    static_assert(std::is_default_constructible_v<T>,
-                  "T must be default-constructible when using new T[cap]");
-    data_ = new T[size_];
+    if constexpr (placement_new) {
+      data_ = static_cast<T *>(::operator new(
+          sizeof(T) * size_, std::align_val_t{alignof(T)}));
+    } else {
+      static_assert(std::is_default_constructible_v<T>,
+                    "T must be default-constructible when using new T[cap]");
+      data_ = new T[size_];
+    }
   }
 
   ~SPSCRingbuffer() {
-    delete[] data_;
+    if constexpr (placement_new) {
+      if constexpr (!std::is_trivially_destructible_v<T>) {
+        const size_t head = head_.load(std::memory_order_acquire);
+        for (size_t i = tail_.load(std::memory_order_relaxed); i != head;
+             i = inc(i)) {
+          std::destroy_at(data_ + i);
+        }
+      }
+      ::operator delete(data_, std::align_val_t{alignof(T)});
+    } else {
+      delete[] data_;
+    }
   }
 
   DISALLOW_COPY(SPSCRingbuffer);
 
-  bool try_push(const T &value) noexcept(
-      std::is_nothrow_assignable_v<T &, const T &>) {
-    const size_t head = head_.load(std::memory_order_relaxed);
-    const size_t next = inc(head);
-    if (next == tail_.load(std::memory_order_acquire)) {
+  bool try_push(const T &value) noexcept(kNothrowPut<const T &>) {
+    const size_t head = producer_slot();
+    if (head == size_) {
       return false; // full
     }
-    data_[head] = value;
-    head_.store(next, std::memory_order_release);
+    put(head, value);
+    head_.store(inc(head), std::memory_order_release);
+    not_empty_.notify();
     return true;
   }
 
-  bool try_push(T &&v) noexcept(std::is_nothrow_assignable_v<T &, T &&>) {
-    const size_t head = head_.load(std::memory_order_relaxed);
-    const size_t next = inc(head);
+  bool try_push(T &&v) noexcept(kNothrowPut<T &&>) {
+    const size_t head = producer_slot();
     // Full
-    if (next == tail_.load(std::memory_order_acquire)) {
+    if (head == size_) {
       return false;
     }
-    data_[head] = std::move(v);
-    head_.store(next, std::memory_order_release);
+    put(head, std::move(v));
+    head_.store(inc(head), std::memory_order_release);
+    not_empty_.notify();
     return true;
   }
 
-  bool push(const T &value, int max_attempt) noexcept(
-      std::is_nothrow_assignable_v<T &, const T &>) {
+  bool push(const T &value,
+            int max_attempt) noexcept(kNothrowPut<const T &>) {
     for (auto i = 0; i < max_attempt; ++i) {
       if (try_push(value)) {
         return true;
@@ -79,8 +112,7 @@ class SPSCRingbuffer {
     return false;
   }
 
-  bool push(T &&value,
-            int max_attempt) noexcept(std::is_nothrow_assignable_v<T &, T &&>) {
+  bool push(T &&value, int max_attempt) noexcept(kNothrowPut<T &&>) {
     for (auto i = 0; i < max_attempt; ++i) {
       if (try_push(std::move(value))) {
         return true;
@@ -90,22 +122,191 @@ class SPSCRingbuffer {
     return false;
   }
 
-  bool pop(T &value) noexcept(std::is_nothrow_assignable_v<T &, T &&> ||
-                              std::is_nothrow_copy_assignable_v<T>) {
-    const size_t tail = tail_.load(std::memory_order_relaxed);
-    // Empty
-    if (tail == head_.load(std::memory_order_acquire)) {
+  /*
+   * @brief Construct an element in place from args, no temporary T is
+   *        created in placement_new mode
+   * @return bool, false when full
+   */
+  template <typename... Args>
+  bool emplace(Args &&...args) noexcept(
+      std::is_nothrow_constructible_v<T, Args...> &&
+      (placement_new || std::is_nothrow_move_assignable_v<T>)) {
+    const size_t head = producer_slot();
+    if (head == size_) {
       return false;
     }
-    if constexpr (std::is_move_assignable_v<T>) {
-      value = std::move(data_[tail]);
+    if constexpr (placement_new) {
+      ::new (static_cast<void *>(data_ + head)) T(std::forward<Args>(args)...);
     } else {
-      value = data_[tail];
+      data_[head] = T(std::forward<Args>(args)...);
     }
+    head_.store(inc(head), std::memory_order_release);
+    not_empty_.notify();
+    return true;
+  }
+
+  /*
+   * @brief Get the next free slot for writing in place, publish it with
+   *        commit(). In placement_new mode the slot is uninitialized storage
+   *        and must be constructed (e.g. placement new) before commit().
+   * @return T*, nullptr when full
+   */
+  T *reserve() noexcept {
+    const size_t head = producer_slot();
+    return head == size_ ? nullptr : data_ + head;
+  }
+
+  /*
+   * @brief Publish the slot returned by the last successful reserve()
+   */
+  void commit() noexcept {
+    head_.store(inc(head_.load(std::memory_order_relaxed)),
+                std::memory_order_release);
+    not_empty_.notify();
+  }
+
+  bool pop(T &value) noexcept(kNothrowTake) {
+    const size_t tail = consumer_slot();
+    // Empty
+    if (tail == size_) {
+      return false;
+    }
+    take(tail, value);
     tail_.store(inc(tail), std::memory_order_release);
+    not_full_.notify();
     return true;
   }
 
+  /*
+   * @brief Push, blocking with the Wait strategy while the ring is full
+   * @param const T &value
+   * @param std::chrono::duration timeout
+   * @return bool, false when still full after timeout
+   */
+  template <class Rep, class Period>
+  bool push_wait(const T &value, std::chrono::duration<Rep, Period> timeout) {
+    if (try_push(value)) {
+      return true;
+    }
+    return not_full_.wait_until([this] { return !full(); },
+                                deadline_after(timeout)) &&
+           try_push(value);
+  }
+
+  template <class Rep, class Period>
+  bool push_wait(T &&value, std::chrono::duration<Rep, Period> timeout) {
+    if (try_push(std::move(value))) {
+      return true;
+    }
+    return not_full_.wait_until([this] { return !full(); },
+                                deadline_after(timeout)) &&
+           try_push(std::move(value));
+  }
+
+  /*
+   * @brief Pop, blocking with the Wait strategy while the ring is empty
+   * @param T &value
+   * @param std::chrono::duration timeout
+   * @return bool, false when still empty after timeout
+   */
+  template <class Rep, class Period>
+  bool pop_wait(T &value, std::chrono::duration<Rep, Period> timeout) {
+    if (pop(value)) {
+      return true;
+    }
+    return not_empty_.wait_until([this] { return !empty(); },
+                                 deadline_after(timeout)) &&
+           pop(value);
+  }
+
+  /*
+   * @brief Get the oldest element for reading in place, drop it with
+   *        release()
+   * @return T*, nullptr when empty
+   */
+  T *front() noexcept {
+    const size_t tail = consumer_slot();
+    return tail == size_ ? nullptr : data_ + tail;
+  }
+
+  /*
+   * @brief Drop the element returned by the last successful front()
+   */
+  void release() noexcept {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if constexpr (placement_new) {
+      std::destroy_at(data_ + tail);
+    }
+    tail_.store(inc(tail), std::memory_order_release);
+    not_full_.notify();
+  }
+
+  /*
+   * @brief Push up to n elements from [first, first + n) with a single
+   *        publish of head_. Use std::make_move_iterator to move elements.
+   * @param InputIt first
+   * @param size_t n
+   * @return size_t, number of elements pushed, may be less than n when full
+   */
+  template <typename InputIt>
+  size_t try_push_n(InputIt first,
+                    size_t n) noexcept(kNothrowPut<decltype(*first)>) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    size_t free = free_slots(head, tail_cache_);
+    if (free < n) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      free = free_slots(head, tail_cache_);
+    }
+    const size_t cnt = std::min(n, free);
+    if (cnt == 0) {
+      return 0;
+    }
+    // At most two contiguous segments: [head, size_) and [0, ...)
+    const size_t first_part = std::min(cnt, size_ - head);
+    for (size_t i = 0; i < first_part; ++i, ++first) {
+      put(head + i, *first);
+    }
+    for (size_t i = 0; i < cnt - first_part; ++i, ++first) {
+      put(i, *first);
+    }
+    const size_t next = head + cnt;
+    head_.store(next >= size_ ? next - size_ : next, std::memory_order_release);
+    not_empty_.notify();
+    return cnt;
+  }
+
+  /*
+   * @brief Pop up to n elements into out with a single publish of tail_
+   * @param OutputIt out
+   * @param size_t n
+   * @return size_t, number of elements popped, 0 when empty
+   */
+  template <typename OutputIt>
+  size_t pop_n(OutputIt out, size_t n) noexcept(
+      std::is_nothrow_assignable_v<decltype(*out), T &&>) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t used = used_slots(head_cache_, tail);
+    if (used < n) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      used = used_slots(head_cache_, tail);
+    }
+    const size_t cnt = std::min(n, used);
+    if (cnt == 0) {
+      return 0;
+    }
+    const size_t first_part = std::min(cnt, size_ - tail);
+    out = std::move(data_ + tail, data_ + tail + first_part, out);
+    std::move(data_, data_ + (cnt - first_part), out);
+    if constexpr (placement_new) {
+      std::destroy(data_ + tail, data_ + tail + first_part);
+      std::destroy(data_, data_ + (cnt - first_part));
+    }
+    const size_t next = tail + cnt;
+    tail_.store(next >= size_ ? next - size_ : next, std::memory_order_release);
+    not_full_.notify();
+    return cnt;
+  }
+
   size_t size() const noexcept {
     const size_t h = head_.load(std::memory_order_acquire);
     const size_t t = tail_.load(std::memory_order_acquire);
@@ -133,10 +334,85 @@ class SPSCRingbuffer {
     return (x + 1) % size_;
   }
 
+  template <typename U>
+  static constexpr bool kNothrowPut =
+      placement_new ? std::is_nothrow_constructible_v<T, U>
+                    : std::is_nothrow_assignable_v<T &, U>;
+
+  static constexpr bool kNothrowTake =
+      std::is_nothrow_assignable_v<T &, T &&> ||
+      std::is_nothrow_copy_assignable_v<T>;
+
+  // Producer: index of the next free slot, or size_ when full
+  size_t producer_slot() noexcept {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t next = inc(head);
+    if (next == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (next == tail_cache_) {
+        return size_;
+      }
+    }
+    return head;
+  }
+
+  // Consumer: index of the oldest element, or size_ when empty
+  size_t consumer_slot() noexcept {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_cache_) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail == head_cache_) {
+        return size_;
+      }
+    }
+    return tail;
+  }
+
+  // Store into a free slot, constructing it in placement_new mode
+  template <typename U>
+  void put(size_t idx, U &&v) noexcept(kNothrowPut<U &&>) {
+    if constexpr (placement_new) {
+      ::new (static_cast<void *>(data_ + idx)) T(std::forward<U>(v));
+    } else {
+      data_[idx] = std::forward<U>(v);
+    }
+  }
+
+  // Move out of an occupied slot, destroying it in placement_new mode
+  void take(size_t idx, T &value) noexcept(kNothrowTake) {
+    if constexpr (std::is_move_assignable_v<T>) {
+      value = std::move(data_[idx]);
+    } else {
+      value = data_[idx];
+    }
+    if constexpr (placement_new) {
+      std::destroy_at(data_ + idx);
+    }
+  }
+
+  // Slots the producer may fill given a view of tail
+  size_t free_slots(size_t head, size_t tail) const noexcept {
+    return tail > head ? tail - head - 1 : size_ - head + tail - 1;
+  }
+
+  // Slots the consumer may drain given a view of head
+  size_t used_slots(size_t head, size_t tail) const noexcept {
+    return head >= tail ? head - tail : size_ - tail + head;
+  }
+
   size_t size_;
   T *data_;
+  // Producer side: head_ is published, tail_cache_ is a private copy of tail_
+  // refreshed only when the queue looks full.
   alignas(64) std::atomic<size_t> head_;
+  size_t tail_cache_;
+  // Consumer side: tail_ is published, head_cache_ is a private copy of head_
+  // refreshed only when the queue looks empty.
   alignas(64) std::atomic<size_t> tail_;
+  size_t head_cache_;
+  // Consumer waits on not_empty_, producer waits on not_full_
+  alignas(64) Wait not_empty_;
+  Wait not_full_;
 };
 
 } // namespace container
@@ -0,0 +1,349 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file unbounded_spsc_queue.hpp
+ * @brief An unbounded SPSC queue made of linked fixed-size chunks.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "container/wait_strategy.hpp"
+#include "macro/macros.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sdk {
+namespace container {
+
+// Thread-safe unbounded SPSC queue (single-producer single-consumer)
+//
+// Elements live in chunks of ChunkSize slots linked into a list:
+//
+//   first_ -> ... spare ... -> consumer chunk -> ... -> producer chunk
+//
+// The producer appends a chunk when its current one fills up, taking it
+// from the spare chunks the consumer has already left behind and only
+// allocating when there is none. Once the queue has grown to its high-water
+// mark, push/pop make no allocations. trim() hands spare chunks back to the
+// allocator after a burst.
+//
+// Same API as SPSCRingbuffer in placement_new mode: elements are constructed
+// in place and destroyed on pop/release. try_push never fails for lack of
+// room, it throws std::bad_alloc if a chunk cannot be allocated.
+template <typename T, size_t ChunkSize = 256, typename Wait = SpinYieldWait<>>
+class UnboundedSPSCQueue {
+  static_assert(ChunkSize >= 2 && (ChunkSize & (ChunkSize - 1)) == 0,
+                "ChunkSize must be a power of two and at least 2");
+
+ public:
+  /*
+   * @brief Preallocate chunks for at least reserve elements
+   * @param size_t reserve
+   */
+  explicit UnboundedSPSCQueue(size_t reserve = 0)
+      : first_(new Chunk), chunks_(1), head_(0), tail_base_(0),
+        consumer_chunk_cache_(nullptr), tail_(0), head_cache_(0),
+        head_base_(0) {
+    Chunk *last = first_;
+    for (size_t n = ChunkSize; n < reserve; n += ChunkSize) {
+      Chunk *c = new Chunk;
+      last->next.store(c, std::memory_order_relaxed);
+      last = c;
+      chunks_.fetch_add(1, std::memory_order_relaxed);
+    }
+    // The last chunk is the active one, the ones before it are spare
+    tail_chunk_ = last;
+    consumer_chunk_cache_ = last;
+    head_chunk_.store(last, std::memory_order_relaxed);
+  }
+
+  ~UnboundedSPSCQueue() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      const uint64_t head = head_.load(std::memory_order_acquire);
+      for (uint64_t i = tail_.load(std::memory_order_relaxed); i != head;
+           ++i) {
+        std::destroy_at(consumer_slot(i));
+      }
+    }
+    for (Chunk *c = first_; c != nullptr;) {
+      Chunk *next = c->next.load(std::memory_order_relaxed);
+      delete c;
+      c = next;
+    }
+  }
+
+  DISALLOW_COPY_AND_MOVE(UnboundedSPSCQueue);
+
+  bool try_push(const T &value) {
+    return emplace(value);
+  }
+
+  bool try_push(T &&value) {
+    return emplace(std::move(value));
+  }
+
+  // Never runs out of room, max_attempt is kept for SPSCRingbuffer parity
+  bool push(const T &value, int /*max_attempt*/) {
+    return emplace(value);
+  }
+
+  bool push(T &&value, int /*max_attempt*/) {
+    return emplace(std::move(value));
+  }
+
+  template <class Rep, class Period>
+  bool push_wait(const T &value, std::chrono::duration<Rep, Period>) {
+    return emplace(value);
+  }
+
+  template <class Rep, class Period>
+  bool push_wait(T &&value, std::chrono::duration<Rep, Period>) {
+    return emplace(std::move(value));
+  }
+
+  template <typename... Args>
+  bool emplace(Args &&...args) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    ::new (static_cast<void *>(producer_slot(head)))
+        T(std::forward<Args>(args)...);
+    head_.store(head + 1, std::memory_order_release);
+    not_empty_.notify();
+    return true;
+  }
+
+  /*
+   * @brief Get the next free slot, it is uninitialized storage and must be
+   *        constructed (e.g. placement new) before commit()
+   * @return T*, never nullptr
+   */
+  T *reserve() {
+    return producer_slot(head_.load(std::memory_order_relaxed));
+  }
+
+  void commit() noexcept {
+    head_.store(head_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+    not_empty_.notify();
+  }
+
+  bool pop(T &value) noexcept(std::is_nothrow_move_assignable_v<T> &&
+                              std::is_nothrow_destructible_v<T>) {
+    T *t = front();
+    if (!t) {
+      return false;
+    }
+    value = std::move(*t);
+    release();
+    return true;
+  }
+
+  /*
+   * @brief Pop, blocking with the Wait strategy while the queue is empty
+   * @return bool, false when still empty after timeout
+   */
+  template <class Rep, class Period>
+  bool pop_wait(T &value, std::chrono::duration<Rep, Period> timeout) {
+    if (pop(value)) {
+      return true;
+    }
+    const auto deadline = deadline_after(timeout);
+    while (not_empty_.wait_until([this] { return !empty(); }, deadline)) {
+      if (pop(value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /*
+   * @brief Get the oldest element for reading in place, drop it with
+   *        release()
+   * @return T*, nullptr when empty
+   */
+  T *front() noexcept {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_cache_) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail == head_cache_) {
+        return nullptr;
+      }
+    }
+    return consumer_slot(tail);
+  }
+
+  void release() noexcept {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    std::destroy_at(consumer_slot(tail));
+    tail_.store(tail + 1, std::memory_order_release);
+  }
+
+  /*
+   * @brief Push n elements from [first, first + n) with a single publish of
+   *        head_. Use std::make_move_iterator to move elements.
+   * @return size_t, always n
+   */
+  template <typename InputIt>
+  size_t try_push_n(InputIt first, size_t n) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < n; ++i, ++first) {
+      ::new (static_cast<void *>(producer_slot(head + i))) T(*first);
+    }
+    if (n != 0) {
+      head_.store(head + n, std::memory_order_release);
+      not_empty_.notify();
+    }
+    return n;
+  }
+
+  /*
+   * @brief Pop up to n elements into out with a single publish of tail_
+   * @return size_t, number of elements popped
+   */
+  template <typename OutputIt>
+  size_t pop_n(OutputIt out, size_t n) noexcept(
+      std::is_nothrow_assignable_v<decltype(*out), T &&>) {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (head_cache_ - tail < n) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+    }
+    const size_t cnt =
+        static_cast<size_t>(std::min<uint64_t>(n, head_cache_ - tail));
+    for (size_t i = 0; i < cnt; ++i, ++out) {
+      T *t = consumer_slot(tail + i);
+      *out = std::move(*t);
+      std::destroy_at(t);
+    }
+    if (cnt != 0) {
+      tail_.store(tail + cnt, std::memory_order_release);
+    }
+    return cnt;
+  }
+
+  /*
+   * @brief Producer: free spare chunks beyond keep, e.g. after a burst
+   * @param size_t keep, spare chunks to hold on to
+   * @return size_t, number of chunks freed
+   */
+  size_t trim(size_t keep = 0) noexcept {
+    consumer_chunk_cache_ = head_chunk_.load(std::memory_order_acquire);
+    size_t spare = 0;
+    for (Chunk *c = first_; c != consumer_chunk_cache_;
+         c = c->next.load(std::memory_order_relaxed)) {
+      ++spare;
+    }
+    size_t freed = 0;
+    for (; spare > keep; --spare, ++freed) {
+      Chunk *c = first_;
+      first_ = c->next.load(std::memory_order_relaxed);
+      delete c;
+    }
+    chunks_.fetch_sub(freed, std::memory_order_relaxed);
+    return freed;
+  }
+
+  size_t size() const noexcept {
+    const uint64_t t = tail_.load(std::memory_order_acquire);
+    const uint64_t h = head_.load(std::memory_order_acquire);
+    return static_cast<size_t>(h - t);
+  }
+
+  bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  bool full() const noexcept {
+    return false;
+  }
+
+  // Slots currently allocated, live and spare
+  size_t capacity() const noexcept {
+    return chunks_.load(std::memory_order_relaxed) * ChunkSize;
+  }
+
+  // Bytes held in chunks, live and spare
+  size_t memory_usage() const noexcept {
+    return chunks_.load(std::memory_order_relaxed) * sizeof(Chunk);
+  }
+
+ private:
+  struct Chunk {
+    alignas(T) unsigned char storage[sizeof(T) * ChunkSize];
+    std::atomic<Chunk *> next{nullptr};
+
+    T *slot(uint64_t pos) noexcept {
+      return std::launder(reinterpret_cast<T *>(
+          storage + (pos & (ChunkSize - 1)) * sizeof(T)));
+    }
+  };
+
+  // Producer: slot for counter pos, linking a new chunk when the current
+  // one is full. Idempotent, so reserve() may be called again before commit.
+  T *producer_slot(uint64_t pos) {
+    if (pos - tail_base_ == ChunkSize) {
+      Chunk *c = spare_chunk();
+      // Published to the consumer by the release store of head_
+      tail_chunk_->next.store(c, std::memory_order_relaxed);
+      tail_chunk_ = c;
+      tail_base_ = pos;
+    }
+    return tail_chunk_->slot(pos);
+  }
+
+  // Consumer: slot for counter pos, pos must be below the published head_
+  T *consumer_slot(uint64_t pos) noexcept {
+    Chunk *c = head_chunk_.load(std::memory_order_relaxed);
+    if (pos - head_base_ == ChunkSize) {
+      // Everything in c has been consumed, it becomes a spare chunk
+      c = c->next.load(std::memory_order_relaxed);
+      head_chunk_.store(c, std::memory_order_release);
+      head_base_ = pos;
+    }
+    return c->slot(pos);
+  }
+
+  // Producer: oldest chunk the consumer has left behind, or a new one
+  Chunk *spare_chunk() {
+    if (first_ == consumer_chunk_cache_) {
+      consumer_chunk_cache_ = head_chunk_.load(std::memory_order_acquire);
+    }
+    if (first_ != consumer_chunk_cache_) {
+      Chunk *c = first_;
+      first_ = c->next.load(std::memory_order_relaxed);
+      c->next.store(nullptr, std::memory_order_relaxed);
+      return c;
+    }
+    Chunk *c = new Chunk;
+    chunks_.fetch_add(1, std::memory_order_relaxed);
+    return c;
+  }
+
+  // Producer side: head_ is published, the rest is private to the producer
+  Chunk *first_;
+  Chunk *tail_chunk_;
+  std::atomic<size_t> chunks_;
+  alignas(64) std::atomic<uint64_t> head_;
+  uint64_t tail_base_;
+  Chunk *consumer_chunk_cache_;
+  // Consumer side: tail_ and head_chunk_ are published
+  alignas(64) std::atomic<uint64_t> tail_;
+  std::atomic<Chunk *> head_chunk_;
+  uint64_t head_cache_;
+  uint64_t head_base_;
+  // Consumer waits on not_empty_
+  alignas(64) Wait not_empty_;
+};
+
+} // namespace container
+} // namespace sdk
@@ -0,0 +1,170 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file wait_strategy.hpp
+ * @brief Wait strategies for the blocking side of the lock-free queues.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include <chrono>
+#include <climits>
+#include <cstdint>
+
+#include <atomic>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace sdk {
+namespace container {
+
+// A wait strategy is owned by a queue, one per waiting direction (not empty,
+// not full), and provides:
+//
+//   template <typename Ready>
+//   bool wait_until(Ready ready, std::chrono::steady_clock::time_point dl);
+//     Block until ready() returns true (true) or dl passes (false).
+//   void notify() noexcept;
+//     Called by the other side after every publish, must be cheap when no
+//     one is waiting.
+
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+// steady_clock::now() + timeout without overflowing for huge timeouts
+template <class Rep, class Period>
+std::chrono::steady_clock::time_point deadline_after(
+    std::chrono::duration<Rep, Period> timeout) noexcept {
+  using Clock = std::chrono::steady_clock;
+  const auto now = Clock::now();
+  if (timeout >= Clock::time_point::max() - now) {
+    return Clock::time_point::max();
+  }
+  return now + std::chrono::duration_cast<Clock::duration>(timeout);
+}
+
+// Lowest latency, burns a core while waiting.
+struct BusySpinWait {
+  template <typename Ready>
+  bool wait_until(Ready ready,
+                  std::chrono::steady_clock::time_point deadline) noexcept {
+    for (uint32_t i = 1;; ++i) {
+      if (ready()) return true;
+      // Reading the clock is far more expensive than a pause
+      if ((i & 1023) == 0 && std::chrono::steady_clock::now() >= deadline) {
+        return ready();
+      }
+      cpu_relax();
+    }
+  }
+
+  void notify() noexcept {}
+};
+
+// Spin for a short while, then give the core away with yield().
+// This is what SPSCRingbuffer::push(value, max_attempt) has always done.
+template <uint32_t SpinCount = 128>
+struct SpinYieldWait {
+  template <typename Ready>
+  bool wait_until(Ready ready,
+                  std::chrono::steady_clock::time_point deadline) noexcept {
+    for (uint32_t i = 0; i < SpinCount; ++i) {
+      if (ready()) return true;
+      cpu_relax();
+    }
+    while (!ready()) {
+      if (std::chrono::steady_clock::now() >= deadline) return ready();
+      std::this_thread::yield();
+    }
+    return true;
+  }
+
+  void notify() noexcept {}
+};
+
+// Spin briefly, then park the waiter on a futex; notify() only issues a
+// syscall when somebody is parked. Falls back to yield() off Linux.
+template <uint32_t SpinCount = 128>
+class FutexWait {
+ public:
+  template <typename Ready>
+  bool wait_until(Ready ready,
+                  std::chrono::steady_clock::time_point deadline) noexcept {
+    for (uint32_t i = 0; i < SpinCount; ++i) {
+      if (ready()) return true;
+      cpu_relax();
+    }
+    while (true) {
+      const uint32_t seq = seq_.load(std::memory_order_acquire);
+      waiters_.fetch_add(1, std::memory_order_seq_cst);
+      // Pairs with the fence in notify(): either we see the publish here or
+      // the notifier sees waiters_ != 0 and bumps seq_
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (ready()) {
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= deadline) {
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return ready();
+      }
+      park(seq, deadline - now);
+      waiters_.fetch_sub(1, std::memory_order_relaxed);
+      if (ready()) return true;
+    }
+  }
+
+  void notify() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_relaxed) == 0) return;
+    seq_.fetch_add(1, std::memory_order_release);
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&seq_), FUTEX_WAKE_PRIVATE,
+            INT_MAX, nullptr, nullptr, 0);
+#endif
+  }
+
+ private:
+  void park(uint32_t seq, std::chrono::steady_clock::duration left) noexcept {
+#ifdef __linux__
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+    const auto ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(left).count();
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+    ts.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+    // Returns immediately with EAGAIN if seq_ already moved on
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&seq_), FUTEX_WAIT_PRIVATE,
+            seq, &ts, nullptr, 0);
+#else
+    (void)seq;
+    (void)left;
+    std::this_thread::yield();
+#endif
+  }
+
+  std::atomic<uint32_t> seq_{0};
+  std::atomic<uint32_t> waiters_{0};
+};
+
+} // namespace container
+} // namespace sdk
@@ -0,0 +1,165 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file work_stealing_deque.hpp
+ * @brief A Chase-Lev work-stealing deque.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "macro/macros.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace sdk {
+namespace container {
+
+// Chase-Lev work-stealing deque (Le et al., "Correct and Efficient
+// Work-Stealing for Weak Memory Models", PPoPP 2013)
+//
+// The owner thread pushes and pops at the bottom (LIFO, cache-warm), any
+// number of thieves steal from the top (FIFO, oldest work first). Only a
+// pop racing a steal for the last element needs a CAS.
+//
+// The array grows on push when full; retired arrays are kept until the deque
+// is destroyed because a thief may still be reading one. T is copied in and
+// out of atomic slots, so it must be trivially copyable: store pointers or
+// indices to the actual work items.
+template <typename T>
+class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "T must be trivially copyable, store a pointer to the task");
+
+ public:
+  explicit WorkStealingDeque(size_t size = 256)
+      : top_(0), bottom_(0) {
+    size_t cap = 2;
+    while (cap < size) cap <<= 1;
+    arrays_.emplace_back(new Array(cap));
+    array_.store(arrays_.back().get(), std::memory_order_relaxed);
+  }
+
+  DISALLOW_COPY_AND_MOVE(WorkStealingDeque);
+
+  /*
+   * @brief Owner: push at the bottom, grows the array when full
+   */
+  void push(T value) {
+    const int64_t b = bottom_.load(std::memory_order_relaxed);
+    const int64_t t = top_.load(std::memory_order_acquire);
+    Array *a = array_.load(std::memory_order_relaxed);
+    if (b - t > a->mask) {
+      a = grow(a, t, b);
+    }
+    a->put(b, value);
+    bottom_.store(b + 1, std::memory_order_release);
+  }
+
+  /*
+   * @brief Owner: pop the most recently pushed element
+   * @return bool, false when empty or a thief took the last element
+   */
+  bool pop(T &value) noexcept {
+    const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Array *a = array_.load(std::memory_order_relaxed);
+    // Claim the bottom slot before looking at top_, pairs with steal()
+    bottom_.store(b, std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_seq_cst);
+    if (t > b) {
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return false; // empty
+    }
+    value = a->get(b);
+    if (t == b) {
+      // Last element, race thieves for it
+      const bool won = top_.compare_exchange_strong(
+          t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  /*
+   * @brief Thief: take the oldest element, safe from any thread
+   * @return bool, false when empty or another thread won the race
+   */
+  bool steal(T &value) noexcept {
+    int64_t t = top_.load(std::memory_order_seq_cst);
+    const int64_t b = bottom_.load(std::memory_order_seq_cst);
+    if (t >= b) {
+      return false;
+    }
+    Array *a = array_.load(std::memory_order_acquire);
+    const T v = a->get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return false;
+    }
+    value = v;
+    return true;
+  }
+
+  // Approximate when thieves are running
+  size_t size() const noexcept {
+    const int64_t b = bottom_.load(std::memory_order_acquire);
+    const int64_t t = top_.load(std::memory_order_acquire);
+    return b > t ? static_cast<size_t>(b - t) : 0;
+  }
+
+  bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  size_t capacity() const noexcept {
+    return static_cast<size_t>(array_.load(std::memory_order_acquire)->mask +
+                               1);
+  }
+
+ private:
+  struct Array {
+    explicit Array(size_t cap)
+        : mask(static_cast<int64_t>(cap) - 1),
+          slots(new std::atomic<T>[cap]) {}
+
+    T get(int64_t i) const noexcept {
+      return slots[i & mask].load(std::memory_order_relaxed);
+    }
+
+    void put(int64_t i, T v) noexcept {
+      slots[i & mask].store(v, std::memory_order_relaxed);
+    }
+
+    const int64_t mask;
+    std::unique_ptr<std::atomic<T>[]> slots;
+  };
+
+  // Owner: copy [t, b) into an array twice the size and publish it
+  Array *grow(Array *a, int64_t t, int64_t b) {
+    arrays_.emplace_back(new Array(static_cast<size_t>(a->mask + 1) * 2));
+    Array *bigger = arrays_.back().get();
+    for (int64_t i = t; i < b; ++i) {
+      bigger->put(i, a->get(i));
+    }
+    array_.store(bigger, std::memory_order_release);
+    return bigger;
+  }
+
+  alignas(64) std::atomic<int64_t> top_;
+  alignas(64) std::atomic<int64_t> bottom_;
+  std::atomic<Array *> array_;
+  // Owner only: every array ever used, the last one is current
+  std::vector<std::unique_ptr<Array>> arrays_;
+};
+
+} // namespace container
+} // namespace sdk
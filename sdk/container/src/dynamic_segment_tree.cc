@@ -0,0 +1,134 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file dynamic_segment_tree.cc
+ * @brief A sparse segment tree over int64_t keys, nodes created on demand.
+ * @author wizyang
+ */
+
+#include "container/dynamic_segment_tree.h"
+
+#include <algorithm>
+
+namespace sdk {
+namespace container {
+
+namespace {
+
+constexpr int64_t kMinValue = std::numeric_limits<int64_t>::min();
+
+// Keys span up to 2^64, so widths and midpoints are computed unsigned
+inline int64_t midpoint(int64_t l, int64_t r) {
+  const uint64_t width = static_cast<uint64_t>(r) - static_cast<uint64_t>(l);
+  return static_cast<int64_t>(static_cast<uint64_t>(l) + (width >> 1));
+}
+
+// diff * (r - l + 1), wrapping like the sums
+inline int64_t scaled(int64_t diff, int64_t l, int64_t r) {
+  const uint64_t len = static_cast<uint64_t>(r) - static_cast<uint64_t>(l) + 1;
+  return static_cast<int64_t>(static_cast<uint64_t>(diff) * len);
+}
+
+inline int64_t wrap_add(int64_t a, int64_t b) {
+  return static_cast<int64_t>(static_cast<uint64_t>(a) +
+                              static_cast<uint64_t>(b));
+}
+
+} // namespace
+
+DynamicSegmentTree::DynamicSegmentTree(int64_t lo, int64_t hi)
+    : lo_(lo), hi_(std::max(lo, hi)) {}
+
+bool DynamicSegmentTree::clip(int64_t &l, int64_t &r) const {
+  l = std::max(l, lo_);
+  r = std::min(r, hi_);
+  return l <= r;
+}
+
+void DynamicSegmentTree::update_range(int64_t diff, int64_t l, int64_t r) {
+  if (diff == 0 || !clip(l, r)) return;
+  root_ = update(root_, lo_, hi_, diff, l, r);
+}
+
+uint32_t DynamicSegmentTree::update(uint32_t node, int64_t l, int64_t r,
+                                    int64_t diff, int64_t ql, int64_t qr) {
+  if (qr < l || ql > r) {
+    return node;
+  }
+  if (node == kNull) {
+    node = pool_.alloc(Node{0, 0, 0, kNull, kNull});
+  }
+  if (l >= ql && r <= qr) {
+    Node &n = pool_[node];
+    n.sum = wrap_add(n.sum, scaled(diff, l, r));
+    n.max = wrap_add(n.max, diff);
+    n.lazy = wrap_add(n.lazy, diff);
+    return node;
+  }
+  const int64_t mid = midpoint(l, r);
+  // Children are created after node, read them through the pool each time
+  const uint32_t left = update(pool_[node].left, l, mid, diff, ql, qr);
+  const uint32_t right = update(pool_[node].right, mid + 1, r, diff, ql, qr);
+  Node &n = pool_[node];
+  n.left = left;
+  n.right = right;
+  const int64_t left_sum = left == kNull ? 0 : pool_[left].sum;
+  const int64_t right_sum = right == kNull ? 0 : pool_[right].sum;
+  const int64_t left_max = left == kNull ? 0 : pool_[left].max;
+  const int64_t right_max = right == kNull ? 0 : pool_[right].max;
+  n.sum = wrap_add(wrap_add(left_sum, right_sum), scaled(n.lazy, l, r));
+  n.max = wrap_add(std::max(left_max, right_max), n.lazy);
+  return node;
+}
+
+int64_t DynamicSegmentTree::query(int64_t l, int64_t r) const {
+  if (!clip(l, r)) return 0;
+  return query(root_, lo_, hi_, l, r);
+}
+
+int64_t DynamicSegmentTree::query(uint32_t node, int64_t l, int64_t r,
+                                  int64_t ql, int64_t qr) const {
+  if (node == kNull || qr < l || ql > r) {
+    return 0;
+  }
+  const Node &n = pool_[node];
+  if (l >= ql && r <= qr) {
+    return n.sum;
+  }
+  const int64_t mid = midpoint(l, r);
+  const int64_t sum = wrap_add(query(n.left, l, mid, ql, qr),
+                               query(n.right, mid + 1, r, ql, qr));
+  return wrap_add(sum, scaled(n.lazy, std::max(l, ql), std::min(r, qr)));
+}
+
+int64_t DynamicSegmentTree::query_max(int64_t l, int64_t r) const {
+  if (!clip(l, r)) return kMinValue;
+  return query_max(root_, lo_, hi_, l, r);
+}
+
+int64_t DynamicSegmentTree::query_max(uint32_t node, int64_t l, int64_t r,
+                                      int64_t ql, int64_t qr) const {
+  // Called only for ranges intersecting [ql, qr]; untouched keys are 0
+  if (node == kNull) {
+    return 0;
+  }
+  const Node &n = pool_[node];
+  if (l >= ql && r <= qr) {
+    return n.max;
+  }
+  const int64_t mid = midpoint(l, r);
+  int64_t res = kMinValue;
+  if (ql <= mid) res = std::max(res, query_max(n.left, l, mid, ql, qr));
+  if (qr > mid) res = std::max(res, query_max(n.right, mid + 1, r, ql, qr));
+  return wrap_add(res, n.lazy);
+}
+
+void DynamicSegmentTree::clear() {
+  pool_.clear();
+  root_ = kNull;
+}
+
+} // namespace container
+} // namespace sdk
@@ -0,0 +1,145 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file iterative_segment_tree.cc
+ * @brief A non-recursive bottom-up segment tree with range add.
+ * @author wizyang
+ */
+
+#include "container/iterative_segment_tree.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace sdk {
+namespace container {
+
+namespace {
+
+constexpr int64_t kMinValue = std::numeric_limits<int64_t>::min();
+
+} // namespace
+
+void IterativeSegmentTree::build() {
+  for (int64_t p = n_ - 1; p > 0; --p) {
+    const Node &a = nodes_[2 * p];
+    const Node &b = nodes_[2 * p + 1];
+    nodes_[p] = Node{a.sum + b.sum, std::max(a.max, b.max), 0};
+  }
+}
+
+void IterativeSegmentTree::apply(int64_t p, int64_t diff, int64_t k) {
+  Node &node = nodes_[p];
+  node.sum += diff * k;
+  node.max += diff;
+  if (p < n_) node.lazy += diff;
+}
+
+void IterativeSegmentTree::rebuild(int64_t p) {
+  // k is the leaf count of a full node at this height; nodes that straddle
+  // two levels when n is not a power of two get a wrong sum, but they are
+  // never taken by a query nor an ancestor of one that is
+  for (int64_t k = 2; p > 1; k <<= 1) {
+    p >>= 1;
+    const Node &a = nodes_[2 * p];
+    const Node &b = nodes_[2 * p + 1];
+    Node &node = nodes_[p];
+    node.sum = a.sum + b.sum + node.lazy * k;
+    node.max = std::max(a.max, b.max) + node.lazy;
+  }
+}
+
+bool IterativeSegmentTree::leaves(int64_t &l, int64_t &r) const {
+  l = std::max<int64_t>(l, 0);
+  r = std::min<int64_t>(r, n_ - 1);
+  if (l > r) return false;
+  l += n_;
+  r += n_ + 1;
+  return true;
+}
+
+void IterativeSegmentTree::update_range(int64_t diff, int64_t l, int64_t r) {
+  if (diff == 0 || !leaves(l, r)) return;
+  const int64_t l0 = l, r0 = r - 1;
+  for (int64_t k = 1; l < r; l >>= 1, r >>= 1, k <<= 1) {
+    if (l & 1) apply(l++, diff, k);
+    if (r & 1) apply(--r, diff, k);
+  }
+  rebuild(l0);
+  rebuild(r0);
+}
+
+int64_t IterativeSegmentTree::query(int64_t l, int64_t r) const {
+  if (!leaves(l, r)) return 0;
+  int64_t sum_l = 0, sum_r = 0;
+  // Elements gathered so far on each side
+  int64_t cnt_l = 0, cnt_r = 0;
+  // Lowest ancestor of each side's nodes whose lazy is accounted for
+  int64_t pl = 0, pr = 0;
+  for (int64_t k = 1; l < r; l >>= 1, r >>= 1, k <<= 1) {
+    if (l & 1) {
+      sum_l += nodes_[l++].sum;
+      cnt_l += k;
+    }
+    if (r & 1) {
+      sum_r += nodes_[--r].sum;
+      cnt_r += k;
+    }
+    // Everything gathered on the left sits under l - 1, on the right under
+    // r, and neither parent is taken later
+    if (cnt_l != 0) {
+      pl = (l - 1) >> 1;
+      sum_l += nodes_[pl].lazy * cnt_l;
+    }
+    if (cnt_r != 0) {
+      pr = r >> 1;
+      sum_r += nodes_[pr].lazy * cnt_r;
+    }
+  }
+  for (pl >>= 1; pl > 0; pl >>= 1) sum_l += nodes_[pl].lazy * cnt_l;
+  for (pr >>= 1; pr > 0; pr >>= 1) sum_r += nodes_[pr].lazy * cnt_r;
+  return sum_l + sum_r;
+}
+
+int64_t IterativeSegmentTree::query_max(int64_t l, int64_t r) const {
+  if (!leaves(l, r)) return kMinValue;
+  int64_t max_l = kMinValue, max_r = kMinValue;
+  bool has_l = false, has_r = false;
+  int64_t pl = 0, pr = 0;
+  for (; l < r; l >>= 1, r >>= 1) {
+    if (l & 1) {
+      max_l = std::max(max_l, nodes_[l++].max);
+      has_l = true;
+    }
+    if (r & 1) {
+      max_r = std::max(max_r, nodes_[--r].max);
+      has_r = true;
+    }
+    if (has_l) {
+      pl = (l - 1) >> 1;
+      max_l += nodes_[pl].lazy;
+    }
+    if (has_r) {
+      pr = r >> 1;
+      max_r += nodes_[pr].lazy;
+    }
+  }
+  for (pl >>= 1; pl > 0; pl >>= 1) max_l += nodes_[pl].lazy;
+  for (pr >>= 1; pr > 0; pr >>= 1) max_r += nodes_[pr].lazy;
+  if (!has_l) return max_r;
+  if (!has_r) return max_l;
+  return std::max(max_l, max_r);
+}
+
+std::vector<int64_t> IterativeSegmentTree::toArray() const {
+  std::vector<int64_t> res(n_);
+  for (int64_t i = 0; i < n_; ++i) {
+    res[i] = query(i, i);
+  }
+  return res;
+}
+
+} // namespace container
+} // namespace sdk
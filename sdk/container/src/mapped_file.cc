@@ -0,0 +1,158 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file mapped_file.cc
+ * @brief A file mapped copy-on-write, and atomic file snapshots.
+ * @author wizyang
+ */
+
+#include "container/mapped_file.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sdk {
+namespace container {
+
+namespace {
+
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+
+inline uint64_t rotl(uint64_t x, int r) {
+  return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t load64(const unsigned char *p) {
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t round64(uint64_t acc, uint64_t word) {
+  return rotl(acc + word * kPrime2, 31) * kPrime1;
+}
+
+// Write all of size bytes at offset, retrying short writes
+bool pwrite_all(int fd, const void *data, size_t size, uint64_t offset) {
+  const auto *p = static_cast<const unsigned char *>(data);
+  while (size > 0) {
+    const ssize_t n = ::pwrite(fd, p, size, static_cast<off_t>(offset));
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    p += n;
+    size -= static_cast<size_t>(n);
+    offset += static_cast<uint64_t>(n);
+  }
+  return true;
+}
+
+} // namespace
+
+uint64_t checksum64(const void *data, size_t size, uint64_t seed) {
+  const auto *p = static_cast<const unsigned char *>(data);
+  const unsigned char *end = p + size;
+  // Four independent lanes keep the multiplies pipelined
+  uint64_t lanes[4] = {seed + kPrime1 + kPrime2, seed + kPrime2, seed,
+                       seed - kPrime1};
+  for (; end - p >= 32; p += 32) {
+    for (int i = 0; i < 4; ++i) {
+      lanes[i] = round64(lanes[i], load64(p + i * 8));
+    }
+  }
+  uint64_t h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) +
+               rotl(lanes[3], 18);
+  h += static_cast<uint64_t>(size);
+  for (; end - p >= 8; p += 8) {
+    h = rotl(h ^ round64(0, load64(p)), 27) * kPrime1 + kPrime3;
+  }
+  for (; p < end; ++p) {
+    h = rotl(h ^ (*p * kPrime3), 11) * kPrime1;
+  }
+  h ^= h >> 33;
+  h *= kPrime2;
+  h ^= h >> 29;
+  h *= kPrime3;
+  h ^= h >> 32;
+  return h;
+}
+
+MappedFile::MappedFile(void *data, size_t size) : data_(data), size_(size) {}
+
+MappedFile::~MappedFile() {
+  if (data_) ::munmap(data_, size_);
+}
+
+std::unique_ptr<MappedFile> MappedFile::OpenPrivate(const std::string &path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) return nullptr;
+  struct stat st {};
+  const int err = ::fstat(fd, &st) != 0 ? errno
+                  : st.st_size <= 0     ? EINVAL
+                                        : 0;
+  if (err != 0) {
+    ::close(fd);
+    errno = err;
+    return nullptr;
+  }
+  const auto size = static_cast<size_t>(st.st_size);
+  void *data =
+      ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  // The mapping keeps the file alive
+  const int map_err = errno;
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    errno = map_err;
+    return nullptr;
+  }
+  return std::unique_ptr<MappedFile>(new MappedFile(data, size));
+}
+
+bool MappedFile::WriteAtomic(const std::string &path,
+                             std::span<const Chunk> chunks) {
+  const std::string tmp = path + ".tmp";
+  const int fd =
+      ::open(tmp.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0644);
+  if (fd < 0) return false;
+
+  uint64_t file_size = 0;
+  bool ok = true;
+  for (const auto &chunk : chunks) {
+    file_size = std::max<uint64_t>(file_size, chunk.offset + chunk.size);
+  }
+  ok = ::ftruncate(fd, static_cast<off_t>(file_size)) == 0;
+  for (size_t i = 0; ok && i < chunks.size(); ++i) {
+    ok = pwrite_all(fd, chunks[i].data, chunks[i].size, chunks[i].offset);
+  }
+  ok = ok && ::fsync(fd) == 0;
+  int err = ok ? 0 : errno;
+  if (::close(fd) != 0 && ok) {
+    ok = false;
+    err = errno;
+  }
+  if (ok && ::rename(tmp.c_str(), path.c_str()) != 0) {
+    ok = false;
+    err = errno;
+  }
+  if (!ok) {
+    ::unlink(tmp.c_str());
+    errno = err;
+  }
+  return ok;
+}
+
+} // namespace container
+} // namespace sdk
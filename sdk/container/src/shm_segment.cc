@@ -0,0 +1,107 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file shm_segment.cc
+ * @brief A shared memory segment (shm_open or memfd) mapped read-write.
+ * @author wizyang
+ */
+
+#include "container/shm_segment.h"
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sdk {
+namespace container {
+
+ShmSegment::ShmSegment(int fd, void *data, size_t size)
+    : fd_(fd), data_(data), size_(size) {}
+
+ShmSegment::~ShmSegment() {
+  if (data_) ::munmap(data_, size_);
+  if (fd_ >= 0) ::close(fd_);
+}
+
+std::unique_ptr<ShmSegment> ShmSegment::Map(int fd, size_t size) {
+  if (size != 0) {
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+      const int err = errno;
+      ::close(fd);
+      errno = err;
+      return nullptr;
+    }
+  } else {
+    struct stat st {};
+    const int err = ::fstat(fd, &st) != 0 ? errno
+                    : st.st_size <= 0     ? EINVAL
+                                          : 0;
+    if (err != 0) {
+      ::close(fd);
+      errno = err;
+      return nullptr;
+    }
+    size = static_cast<size_t>(st.st_size);
+  }
+
+  void *data =
+      ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED) {
+    const int err = errno;
+    ::close(fd);
+    errno = err;
+    return nullptr;
+  }
+  return std::unique_ptr<ShmSegment>(new ShmSegment(fd, data, size));
+}
+
+std::unique_ptr<ShmSegment> ShmSegment::Create(const std::string &name,
+                                               size_t size) {
+  if (size == 0) {
+    errno = EINVAL;
+    return nullptr;
+  }
+  const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) return nullptr;
+  auto seg = Map(fd, size);
+  if (!seg) {
+    const int err = errno;
+    ::shm_unlink(name.c_str());
+    errno = err;
+  }
+  return seg;
+}
+
+std::unique_ptr<ShmSegment> ShmSegment::Open(const std::string &name) {
+  const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0) return nullptr;
+  return Map(fd, 0);
+}
+
+std::unique_ptr<ShmSegment> ShmSegment::CreateAnonymous(size_t size) {
+  if (size == 0) {
+    errno = EINVAL;
+    return nullptr;
+  }
+  const int fd = ::memfd_create("sdk_shm_segment", 0);
+  if (fd < 0) return nullptr;
+  return Map(fd, size);
+}
+
+std::unique_ptr<ShmSegment> ShmSegment::FromFd(int fd) {
+  const int dup_fd = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  if (dup_fd < 0) return nullptr;
+  return Map(dup_fd, 0);
+}
+
+bool ShmSegment::Unlink(const std::string &name) {
+  return ::shm_unlink(name.c_str()) == 0;
+}
+
+} // namespace container
+} // namespace sdk
@@ -0,0 +1,176 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file bip_buffer_test.cc
+ * @brief A test suite for the variable-length SPSC byte ring.
+ * @author wizyang
+ */
+
+#include "container/bip_buffer.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+using sdk::container::BipBuffer;
+
+static std::vector<uint8_t> MakePayload(uint32_t seq, size_t len) {
+  std::vector<uint8_t> v(len);
+  for (size_t i = 0; i < len; ++i) v[i] = static_cast<uint8_t>(seq + i);
+  return v;
+}
+
+TEST(BipBufferTest, WriteRead) {
+  BipBuffer ring(256);
+  EXPECT_TRUE(ring.empty());
+
+  size_t len = 0;
+  EXPECT_EQ(ring.front(&len), nullptr);
+
+  const std::vector<uint8_t> a = {1, 2, 3};
+  const std::vector<uint8_t> b(100, 7);
+  EXPECT_TRUE(ring.try_write(a.data(), a.size()));
+  EXPECT_TRUE(ring.try_write(b.data(), b.size()));
+  EXPECT_TRUE(ring.try_write(nullptr, 0));
+
+  const uint8_t *p = ring.front(&len);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(std::vector<uint8_t>(p, p + len), a);
+  ring.release();
+
+  p = ring.front(&len);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(std::vector<uint8_t>(p, p + len), b);
+  ring.release();
+
+  p = ring.front(&len);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(len, 0u);
+  ring.release();
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST(BipBufferTest, ReserveCommitShorter) {
+  BipBuffer ring(128);
+  uint8_t *p = ring.reserve(64);
+  ASSERT_NE(p, nullptr);
+  std::memcpy(p, "hello", 5);
+  ring.commit(5);
+
+  size_t len = 0;
+  const uint8_t *q = ring.front(&len);
+  ASSERT_NE(q, nullptr);
+  EXPECT_EQ(len, 5u);
+  EXPECT_EQ(std::memcmp(q, "hello", 5), 0);
+  ring.release();
+}
+
+TEST(BipBufferTest, FullAndWrap) {
+  BipBuffer ring(128);
+  // 8 header + 40 payload = 48 bytes per record
+  const auto payload = MakePayload(0, 40);
+  EXPECT_TRUE(ring.try_write(payload.data(), payload.size()));
+  EXPECT_TRUE(ring.try_write(payload.data(), payload.size()));
+  // 96 used, 32 left at the tail, nothing free at the head
+  EXPECT_FALSE(ring.try_write(payload.data(), payload.size()));
+
+  size_t len = 0;
+  ASSERT_NE(ring.front(&len), nullptr);
+  ring.release();
+  // Head has 48 free bytes but a record must stay strictly below read_
+  EXPECT_FALSE(ring.try_write(payload.data(), payload.size()));
+  const auto small = MakePayload(1, 24);
+  EXPECT_TRUE(ring.try_write(small.data(), small.size()));
+
+  const uint8_t *p = ring.front(&len);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(std::vector<uint8_t>(p, p + len), payload);
+  ring.release();
+
+  // Follows the wrap marker to offset 0
+  p = ring.front(&len);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(std::vector<uint8_t>(p, p + len), small);
+  ring.release();
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST(BipBufferTest, HalfCapacityAlwaysFitsWhenEmpty) {
+  BipBuffer ring(256);
+  const size_t max_payload = ring.capacity() / 2 - BipBuffer::kHeaderSize;
+  for (size_t shift = 0; shift < 16; ++shift) {
+    const auto small = MakePayload(0, shift * 8);
+    ASSERT_TRUE(ring.try_write(small.data(), small.size()));
+    size_t len = 0;
+    ASSERT_NE(ring.front(&len), nullptr);
+    ring.release();
+
+    const auto big = MakePayload(0, max_payload);
+    ASSERT_TRUE(ring.try_write(big.data(), big.size())) << "shift=" << shift;
+    ASSERT_NE(ring.front(&len), nullptr);
+    EXPECT_EQ(len, max_payload);
+    ring.release();
+  }
+}
+
+TEST(BipBufferTest, HugeReserveFails) {
+  BipBuffer ring(256);
+  EXPECT_EQ(ring.reserve(SIZE_MAX), nullptr);
+  EXPECT_EQ(ring.reserve(SIZE_MAX - BipBuffer::kHeaderSize + 1), nullptr);
+  EXPECT_EQ(ring.reserve(ring.capacity()), nullptr);
+  EXPECT_TRUE(ring.empty());
+
+  // The ring is still usable afterwards
+  const auto payload = MakePayload(1, 16);
+  ASSERT_TRUE(ring.try_write(payload.data(), payload.size()));
+  size_t len = 0;
+  ASSERT_NE(ring.front(&len), nullptr);
+  EXPECT_EQ(len, payload.size());
+}
+
+TEST(BipBufferTest, SPSC_Stress) {
+  const uint32_t N = 100000;
+  BipBuffer ring(4096);
+
+  std::thread prod_th([&] {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> dist(0, 300);
+    for (uint32_t i = 0; i < N; ++i) {
+      const size_t len = sizeof(uint32_t) + dist(rng);
+      uint8_t *p;
+      while ((p = ring.reserve(len)) == nullptr) {
+        std::this_thread::yield();
+      }
+      std::memcpy(p, &i, sizeof(i));
+      for (size_t k = sizeof(i); k < len; ++k) p[k] = static_cast<uint8_t>(k);
+      ring.commit(len);
+    }
+  });
+
+  uint32_t expected = 0;
+  while (expected < N) {
+    size_t len = 0;
+    const uint8_t *p = ring.front(&len);
+    if (!p) {
+      std::this_thread::yield();
+      continue;
+    }
+    uint32_t seq;
+    ASSERT_GE(len, sizeof(seq));
+    std::memcpy(&seq, p, sizeof(seq));
+    ASSERT_EQ(seq, expected);
+    for (size_t k = sizeof(seq); k < len; ++k) {
+      ASSERT_EQ(p[k], static_cast<uint8_t>(k));
+    }
+    ring.release();
+    ++expected;
+  }
+  prod_th.join();
+  EXPECT_TRUE(ring.empty());
+}
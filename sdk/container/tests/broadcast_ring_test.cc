@@ -0,0 +1,138 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file broadcast_ring_test.cc
+ * @brief A test suite for the broadcast (multicast) ring.
+ * @author wizyang
+ */
+
+#include "container/broadcast_ring.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using sdk::container::BroadcastRing;
+using sdk::container::FutexWait;
+
+TEST(BroadcastRingTest, EveryConsumerSeesEveryEvent) {
+  BroadcastRing<int> ring(4);
+  auto *a = ring.add_consumer();
+  auto *b = ring.add_consumer();
+  EXPECT_EQ(ring.capacity(), 4u);
+
+  for (int i = 0; i < 4; ++i) EXPECT_TRUE(ring.try_push(i));
+  // Both consumers gate the producer
+  EXPECT_FALSE(ring.try_push(-1));
+  EXPECT_TRUE(ring.full());
+
+  int x = -1;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(a->pop(x));
+    EXPECT_EQ(x, i);
+  }
+  EXPECT_FALSE(a->pop(x));
+  // b has not released anything yet
+  EXPECT_FALSE(ring.try_push(-1));
+
+  EXPECT_TRUE(b->pop(x));
+  EXPECT_EQ(x, 0);
+  EXPECT_TRUE(ring.try_push(4));
+  EXPECT_TRUE(a->pop(x));
+  EXPECT_EQ(x, 4);
+
+  std::vector<int> rest;
+  EXPECT_EQ(b->consume([&](const int &v) { rest.push_back(v); }), 4u);
+  EXPECT_EQ(rest, (std::vector<int>{1, 2, 3, 4}));
+  EXPECT_EQ(a->sequence(), 5u);
+  EXPECT_EQ(b->sequence(), 5u);
+}
+
+TEST(BroadcastRingTest, BarrierOrdersDependentConsumer) {
+  BroadcastRing<int> ring(8);
+  auto *first = ring.add_consumer();
+  auto *second = ring.add_consumer();
+  auto *after = ring.add_consumer({first, second});
+
+  for (int i = 0; i < 3; ++i) EXPECT_TRUE(ring.try_push(i));
+  EXPECT_EQ(after->front(), nullptr);
+  EXPECT_EQ(after->available(), 0u);
+
+  first->consume([](const int &) {});
+  EXPECT_EQ(after->front(), nullptr);
+  second->consume([](const int &) {}, 2);
+  EXPECT_EQ(after->available(), 2u);
+
+  int x = -1;
+  EXPECT_TRUE(after->pop(x));
+  EXPECT_EQ(x, 0);
+  EXPECT_TRUE(after->pop(x));
+  EXPECT_EQ(x, 1);
+  EXPECT_FALSE(after->pop(x));
+
+  // The dependent consumer alone now gates the producer
+  for (int i = 3; i < 10; ++i) EXPECT_TRUE(ring.try_push(i));
+  EXPECT_FALSE(ring.try_push(-1));
+}
+
+TEST(BroadcastRingTest, BatchPushAndWait) {
+  BroadcastRing<int, FutexWait<>> ring(4);
+  auto *c = ring.add_consumer();
+  const int in[] = {1, 2, 3, 4, 5, 6};
+  EXPECT_EQ(ring.try_push_n(in, 6), 4u);
+  EXPECT_FALSE(ring.push_wait(7, std::chrono::milliseconds(1)));
+
+  int x = 0;
+  std::thread t([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    c->pop(x);
+  });
+  EXPECT_TRUE(ring.push_wait(7, std::chrono::seconds(5)));
+  t.join();
+  EXPECT_EQ(x, 1);
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(c->pop_wait(x, std::chrono::seconds(1)));
+  }
+  EXPECT_EQ(x, 7);
+  EXPECT_FALSE(c->pop_wait(x, std::chrono::milliseconds(1)));
+}
+
+TEST(BroadcastRingTest, FanOutStress) {
+  const uint64_t kCount = 100000;
+  BroadcastRing<uint64_t> ring(64);
+  auto *a = ring.add_consumer();
+  auto *b = ring.add_consumer();
+  auto *c = ring.add_consumer({a, b});
+
+  std::atomic<bool> ok{true};
+  auto run = [&](BroadcastRing<uint64_t>::Consumer *cons,
+                 BroadcastRing<uint64_t>::Consumer *upstream) {
+    uint64_t expect = 0;
+    while (expect < kCount) {
+      const size_t n = cons->consume([&](const uint64_t &v) {
+        if (v != expect) ok = false;
+        // A dependent consumer never runs ahead of its upstream
+        if (upstream && upstream->sequence() <= expect) ok = false;
+        ++expect;
+      });
+      if (n == 0) std::this_thread::yield();
+    }
+  };
+  std::thread ta(run, a, nullptr);
+  std::thread tb(run, b, nullptr);
+  std::thread tc(run, c, a);
+
+  for (uint64_t i = 0; i < kCount; ++i) {
+    while (!ring.try_push(i)) std::this_thread::yield();
+  }
+  ta.join();
+  tb.join();
+  tc.join();
+  EXPECT_TRUE(ok.load());
+  EXPECT_EQ(c->sequence(), kCount);
+}
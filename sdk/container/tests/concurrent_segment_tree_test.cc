@@ -0,0 +1,96 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file concurrent_segment_tree_test.cc
+ * @brief A test suite for the single-writer multi-reader segment tree.
+ * @author wizyang
+ */
+
+#include "container/concurrent_segment_tree.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using sdk::container::ConcurrentSegmentTree;
+using sdk::container::MaxOp;
+
+TEST(ConcurrentSegmentTreeTest, BasicQueryAndUpdate) {
+  std::vector<int> data = {1, 2, 3, 4, 5};
+  ConcurrentSegmentTree<> st(data);
+  EXPECT_EQ(st.size(), 5);
+  EXPECT_EQ(st.query(0, 4), 15);
+  EXPECT_EQ(st.version(), 0u);
+
+  st.update_range(2, 1, 3); // => [1,4,5,6,5]
+  EXPECT_EQ(st.query(0, 4), 21);
+  EXPECT_EQ(st.aggregate(0, 4).max, 6);
+  EXPECT_EQ(st.version(), 1u);
+
+  // Both copies received the update
+  st.set(0, 10); // => [10,4,5,6,5]
+  EXPECT_EQ(st.query(0, 4), 30);
+  st.update_range(-1, 0, 4);
+  EXPECT_EQ(st.read([](const auto &tree) { return tree.toArray(); }),
+            (std::vector<int64_t>{9, 3, 4, 5, 4}));
+  EXPECT_EQ(st.version(), 3u);
+}
+
+TEST(ConcurrentSegmentTreeTest, WriteBatchIsOneVersion) {
+  std::vector<int64_t> data(8, 0);
+  ConcurrentSegmentTree<int64_t, MaxOp<int64_t>> st(data);
+  st.write([](auto &tree) {
+    tree.update_range(3, 0, 3);
+    tree.update_range(4, 2, 7);
+  });
+  EXPECT_EQ(st.version(), 1u);
+  EXPECT_EQ(st.query(0, 7), 7);
+  EXPECT_EQ(st.query(4, 7), 4);
+}
+
+// Every write adds 1 to all elements, readers check within one snapshot
+// that the halves add up and the values are uniform, and that versions never
+// go backwards
+TEST(ConcurrentSegmentTreeTest, ReadersSeeConsistentSnapshots) {
+  const int n = 1000;
+  std::vector<int64_t> data(n, 0);
+  ConcurrentSegmentTree<> st(data);
+  std::atomic<bool> done{false};
+  std::atomic<int> failures{0};
+
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 3; ++t) {
+    readers.emplace_back([&] {
+      int64_t last = 0;
+      while (!done.load(std::memory_order_acquire)) {
+        st.read([&](const auto &tree) {
+          const int64_t total = tree.query(0, n - 1);
+          const int64_t left = tree.query(0, n / 2 - 1);
+          const int64_t right = tree.query(n / 2, n - 1);
+          const auto stats = tree.aggregate(0, n - 1);
+          if (left + right != total || total % n != 0 ||
+              stats.min != stats.max || stats.max * n != total ||
+              total < last) {
+            failures.fetch_add(1);
+          }
+          last = total;
+        });
+        std::this_thread::yield();
+      }
+    });
+  }
+
+  const int kWrites = 2000;
+  for (int i = 0; i < kWrites; ++i) {
+    st.update_range(1, 0, n - 1);
+  }
+  done.store(true, std::memory_order_release);
+  for (auto &reader : readers) reader.join();
+
+  EXPECT_EQ(failures.load(), 0);
+  EXPECT_EQ(st.query(0, n - 1), int64_t{kWrites} * n);
+  EXPECT_EQ(st.version(), static_cast<uint64_t>(kWrites));
+}
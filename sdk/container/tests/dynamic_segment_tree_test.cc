@@ -0,0 +1,95 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file dynamic_segment_tree_test.cc
+ * @brief A test suite for the sparse segment tree.
+ * @author wizyang
+ */
+
+#include "container/dynamic_segment_tree.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <map>
+#include <numeric>
+#include <random>
+
+using sdk::container::DynamicSegmentTree;
+
+TEST(DynamicSegmentTreeTest, FullKeySpace) {
+  DynamicSegmentTree st;
+  EXPECT_EQ(st.query(INT64_MIN, INT64_MAX), 0);
+  EXPECT_EQ(st.query_max(INT64_MIN, INT64_MAX), 0);
+
+  const int64_t t0 = 1700000000000000000;
+  st.add(t0, 5);
+  st.add(-t0, 7);
+  st.update_range(2, t0 - 10, t0 + 10); // 21 keys
+  EXPECT_EQ(st.query(INT64_MIN, INT64_MAX), 5 + 7 + 42);
+  EXPECT_EQ(st.query(t0, t0), 7);
+  EXPECT_EQ(st.query(t0 + 1, INT64_MAX), 20);
+  EXPECT_EQ(st.query(-t0, -t0), 7);
+  EXPECT_EQ(st.query_max(INT64_MIN, INT64_MAX), 7);
+  EXPECT_EQ(st.query_max(t0 + 1, t0 + 100), 2);
+  EXPECT_EQ(st.query_max(t0 + 11, INT64_MAX), 0);
+
+  // Extremes of the key space
+  st.add(INT64_MIN, -3);
+  st.add(INT64_MAX, 4);
+  EXPECT_EQ(st.query(INT64_MIN, INT64_MIN), -3);
+  EXPECT_EQ(st.query(INT64_MAX, INT64_MAX), 4);
+  EXPECT_EQ(st.query_max(INT64_MIN, INT64_MIN), -3);
+
+  // Memory follows the touched paths, not the key space
+  EXPECT_LT(st.node_count(), 6u * 2 * 64);
+}
+
+TEST(DynamicSegmentTreeTest, BoundedRangeAndClear) {
+  DynamicSegmentTree st(100, 199);
+  st.update_range(1, 0, 1000); // clipped to [100, 199]
+  EXPECT_EQ(st.query(0, 1000), 100);
+  EXPECT_EQ(st.query(150, 159), 10);
+  EXPECT_EQ(st.query(200, 300), 0);
+  EXPECT_EQ(st.query_max(200, 300), INT64_MIN);
+  st.update_range(-5, 120, 129);
+  EXPECT_EQ(st.query_max(100, 199), 1);
+  EXPECT_EQ(st.query_max(120, 125), -4);
+
+  const size_t capacity = st.memory_usage();
+  st.clear();
+  EXPECT_EQ(st.node_count(), 0u);
+  EXPECT_EQ(st.memory_usage(), capacity);
+  EXPECT_EQ(st.query(0, 1000), 0);
+  st.add(150, 3);
+  EXPECT_EQ(st.query(100, 199), 3);
+}
+
+// Random range adds on sparse keys against a map of per-key values
+TEST(DynamicSegmentTreeTest, RandomAgainstNaive) {
+  std::mt19937_64 rng(42);
+  const int64_t base = -(int64_t{1} << 50);
+  const int64_t width = 400;
+  DynamicSegmentTree st;
+  std::vector<int64_t> ref(width, 0);
+  auto key = [&] { return static_cast<int64_t>(rng() % width); };
+
+  for (int it = 0; it < 3000; ++it) {
+    int64_t l = key(), r = key();
+    if (l > r) std::swap(l, r);
+    if (it % 2 == 0) {
+      const int64_t d = static_cast<int64_t>(rng() % 200) - 100;
+      for (int64_t i = l; i <= r; ++i) ref[i] += d;
+      st.update_range(d, base + l, base + r);
+      continue;
+    }
+    const auto first = ref.begin() + l, last = ref.begin() + r + 1;
+    ASSERT_EQ(st.query(base + l, base + r),
+              std::accumulate(first, last, int64_t{0}));
+    ASSERT_EQ(st.query_max(base + l, base + r), *std::max_element(first, last));
+  }
+  // Keys outside the touched window are still 0
+  EXPECT_EQ(st.query_max(base + width, INT64_MAX), 0);
+  EXPECT_EQ(st.query(INT64_MIN, base - 1), 0);
+}
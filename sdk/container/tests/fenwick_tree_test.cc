@@ -0,0 +1,133 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file fenwick_tree_test.cc
+ * @brief A test suite for the Fenwick trees.
+ * @author wizyang
+ */
+
+#include "container/fenwick_tree.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+
+using sdk::container::FenwickTree;
+using sdk::container::RangeFenwickTree;
+
+TEST(FenwickTreeTest, PointAddAndRangeSum) {
+  std::vector<int> data = {1, 2, 3, 4, 5};
+  FenwickTree<> ft(data);
+  EXPECT_EQ(ft.size(), 5u);
+  EXPECT_EQ(ft.prefix_sum(0), 1);
+  EXPECT_EQ(ft.prefix_sum(4), 15);
+  EXPECT_EQ(ft.query(1, 3), 9);
+
+  ft.add(2, 10); // => [1,2,13,4,5]
+  EXPECT_EQ(ft.query(2, 2), 13);
+  EXPECT_EQ(ft.query(0, 4), 25);
+
+  // Out of range parts are clipped, empty ranges give 0
+  EXPECT_EQ(ft.query(3, 100), 9);
+  EXPECT_EQ(ft.query(5, 9), 0);
+  EXPECT_EQ(ft.query(3, 2), 0);
+}
+
+TEST(FenwickTreeTest, Empty) {
+  FenwickTree<> ft(0);
+  EXPECT_EQ(ft.size(), 0u);
+  EXPECT_EQ(ft.query(0, 10), 0);
+  EXPECT_EQ(ft.lower_bound(1), 0u);
+
+  RangeFenwickTree<> rft(0);
+  rft.update_range(1, 0, 10);
+  EXPECT_EQ(rft.query(0, 10), 0);
+}
+
+TEST(FenwickTreeTest, LowerBound) {
+  // Counts per bucket, lower_bound(k) finds the bucket of the k-th unit
+  std::vector<int> counts = {0, 3, 0, 2, 5, 0, 1};
+  FenwickTree<> ft(counts);
+  EXPECT_EQ(ft.lower_bound(0), 0u);
+  EXPECT_EQ(ft.lower_bound(1), 1u);
+  EXPECT_EQ(ft.lower_bound(3), 1u);
+  EXPECT_EQ(ft.lower_bound(4), 3u);
+  EXPECT_EQ(ft.lower_bound(5), 3u);
+  EXPECT_EQ(ft.lower_bound(6), 4u);
+  EXPECT_EQ(ft.lower_bound(10), 4u);
+  EXPECT_EQ(ft.lower_bound(11), 6u);
+  EXPECT_EQ(ft.lower_bound(12), ft.size());
+
+  ft.add(6, -1);
+  ft.add(2, 4); // => [0,3,4,2,5,0,0]
+  EXPECT_EQ(ft.lower_bound(4), 2u);
+  EXPECT_EQ(ft.lower_bound(14), 4u);
+  EXPECT_EQ(ft.lower_bound(15), ft.size());
+}
+
+TEST(FenwickTreeTest, RangeAddRangeSum) {
+  std::vector<int> data = {1, 2, 3, 4, 5};
+  RangeFenwickTree<> ft(data);
+  EXPECT_EQ(ft.query(0, 4), 15);
+  EXPECT_EQ(ft.query(1, 3), 9);
+
+  ft.update_range(2, 1, 3); // => [1,4,5,6,5]
+  EXPECT_EQ(ft.query(0, 4), 21);
+  EXPECT_EQ(ft.query(1, 3), 15);
+  EXPECT_EQ(ft.query(4, 4), 5);
+
+  ft.update_range(-1, 3, 100); // => [1,4,5,5,4]
+  EXPECT_EQ(ft.query(3, 4), 9);
+  EXPECT_EQ(ft.prefix_sum(2), 10);
+}
+
+// Random operations against a plain array, n from 1 to 70
+TEST(FenwickTreeTest, RandomAgainstNaive) {
+  std::mt19937 rng(42);
+  for (int n = 1; n <= 70; ++n) {
+    std::uniform_int_distribution<int> value(0, 100);
+    std::uniform_int_distribution<int> index(0, n - 1);
+    std::vector<int64_t> data(n);
+    for (auto &v : data) v = value(rng);
+
+    FenwickTree<> point(data);
+    RangeFenwickTree<> range(data);
+    std::vector<int64_t> a = data, b = data;
+    for (int round = 0; round < 200; ++round) {
+      int l = index(rng), r = index(rng);
+      if (l > r) std::swap(l, r);
+      const int64_t diff = value(rng) - 50;
+      switch (round % 3) {
+        case 0:
+          point.add(l, diff);
+          a[l] += diff;
+          break;
+        case 1:
+          range.update_range(diff, l, r);
+          for (int i = l; i <= r; ++i) b[i] += diff;
+          break;
+        default:
+          break;
+      }
+      const auto expect_a = std::accumulate(a.begin() + l, a.begin() + r + 1,
+                                            int64_t{0});
+      const auto expect_b = std::accumulate(b.begin() + l, b.begin() + r + 1,
+                                            int64_t{0});
+      ASSERT_EQ(point.query(l, r), expect_a) << "n=" << n;
+      ASSERT_EQ(range.query(l, r), expect_b) << "n=" << n;
+    }
+
+    // lower_bound against a linear scan, on non-negative data only
+    FenwickTree<> counts(data);
+    int64_t total = std::accumulate(data.begin(), data.end(), int64_t{0});
+    for (int64_t k = 1; k <= total + 1; k += 7) {
+      size_t expect = 0;
+      int64_t sum = 0;
+      while (expect < data.size() && (sum += data[expect]) < k) ++expect;
+      ASSERT_EQ(counts.lower_bound(k), expect) << "n=" << n << " k=" << k;
+    }
+  }
+}
@@ -0,0 +1,139 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file fixed_ringbuffer_test.cc
+ * @brief A test suite for the fixed capacity SPSC ring buffer.
+ * @author wizyang
+ */
+
+#include "container/fixed_spsc_ringbuffer.hpp"
+
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+using sdk::container::FixedSPSCRingbuffer;
+
+struct NoDefault {
+  DISALLOW_COPY(NoDefault);
+  static inline int live{0};
+  std::string s;
+
+  explicit NoDefault(std::string str) : s(std::move(str)) {
+    ++live;
+  }
+  NoDefault(NoDefault &&rhs) noexcept : s(std::move(rhs.s)) {
+    ++live;
+  }
+  NoDefault &operator=(NoDefault &&) noexcept = default;
+  ~NoDefault() {
+    --live;
+  }
+};
+
+TEST(FixedSPSCRingbuffer, UsesFullCapacity) {
+  FixedSPSCRingbuffer<int, 8> rb;
+  EXPECT_TRUE(rb.empty());
+  EXPECT_EQ(rb.capacity(), 8u);
+
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_TRUE(rb.try_push(i));
+  }
+  EXPECT_TRUE(rb.full());
+  EXPECT_FALSE(rb.try_push(8));
+  EXPECT_EQ(rb.size(), 8u);
+
+  for (int i = 0; i < 8; ++i) {
+    int x = -1;
+    EXPECT_TRUE(rb.pop(x));
+    EXPECT_EQ(x, i);
+  }
+  int dummy = 0;
+  EXPECT_FALSE(rb.pop(dummy));
+  EXPECT_TRUE(rb.empty());
+}
+
+TEST(FixedSPSCRingbuffer, WrapAroundAndBatch) {
+  FixedSPSCRingbuffer<int, 8> rb;
+  int next_in = 0, next_out = 0;
+
+  for (int round = 0; round < 100; ++round) {
+    std::vector<int> in(5);
+    for (auto &x : in) x = next_in++;
+    ASSERT_EQ(rb.try_push_n(in.begin(), in.size()), in.size());
+    ASSERT_TRUE(rb.try_push(next_in++));
+
+    std::vector<int> out(6, -1);
+    ASSERT_EQ(rb.pop_n(out.begin(), out.size()), out.size());
+    for (auto x : out) EXPECT_EQ(x, next_out++);
+  }
+
+  std::vector<int> in(10, 7);
+  EXPECT_EQ(rb.try_push_n(in.begin(), in.size()), 8u);
+  EXPECT_TRUE(rb.full());
+}
+
+TEST(FixedSPSCRingbuffer, NonDefaultConstructible) {
+  NoDefault::live = 0;
+  {
+    FixedSPSCRingbuffer<NoDefault, 4> rb;
+    EXPECT_TRUE(rb.emplace("a"));
+    EXPECT_TRUE(rb.try_push(NoDefault{"b"}));
+
+    NoDefault *slot = rb.reserve();
+    ASSERT_NE(slot, nullptr);
+    ::new (static_cast<void *>(slot)) NoDefault("c");
+    rb.commit();
+    EXPECT_EQ(NoDefault::live, 3);
+
+    NoDefault *t = rb.front();
+    ASSERT_NE(t, nullptr);
+    EXPECT_EQ(t->s, "a");
+    rb.release();
+
+    NoDefault out{""};
+    EXPECT_TRUE(rb.pop(out));
+    EXPECT_EQ(out.s, "b");
+    // "c" is left for the destructor
+  }
+  EXPECT_EQ(NoDefault::live, 0);
+}
+
+TEST(FixedSPSCRingbuffer, SPSC_Stress) {
+  const size_t N = 100000;
+  FixedSPSCRingbuffer<int, 1024> rb;
+  std::vector<int> out;
+  out.reserve(N);
+
+  std::thread prod_th([&] {
+    for (size_t i = 0; i < N; ++i) {
+      while (!rb.push(static_cast<int>(i), 256)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::thread cons_th([&] {
+    int x;
+    while (out.size() < N) {
+      if (rb.pop(x)) {
+        out.push_back(x);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  prod_th.join();
+  cons_th.join();
+
+  ASSERT_EQ(out.size(), N);
+  for (size_t i = 0; i < N; ++i) {
+    EXPECT_EQ(out[i], (int)i);
+  }
+  EXPECT_TRUE(rb.empty());
+}
@@ -0,0 +1,63 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file iterative_segment_tree_test.cc
+ * @brief A test suite for the bottom-up segment tree.
+ * @author wizyang
+ */
+
+#include "container/iterative_segment_tree.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+
+using sdk::container::IterativeSegmentTree;
+
+TEST(IterativeSegmentTreeTest, BasicQueryAndUpdate) {
+  std::vector<int> data = {1, 2, 3, 4, 5};
+  IterativeSegmentTree st(data);
+  EXPECT_EQ(st.query(0, 4), 15);
+  EXPECT_EQ(st.query(1, 3), 9);
+  EXPECT_EQ(st.query_max(0, 3), 4);
+
+  st.update_range(2, 1, 3); // => [1,4,5,6,5]
+  EXPECT_EQ(st.query(0, 4), 21);
+  EXPECT_EQ(st.query(1, 3), 15);
+  EXPECT_EQ(st.query_max(0, 4), 6);
+  EXPECT_EQ(st.toArray(), (std::vector<int64_t>{1, 4, 5, 6, 5}));
+
+  // Out of range parts are clipped, empty ranges give the identity
+  EXPECT_EQ(st.query(3, 100), 11);
+  EXPECT_EQ(st.query(5, 9), 0);
+  EXPECT_EQ(st.query_max(5, 9), INT64_MIN);
+}
+
+// Every n from 1 to 70, including the non power of two shapes where some
+// nodes straddle two levels
+TEST(IterativeSegmentTreeTest, RandomAgainstNaive) {
+  std::mt19937 rng(7);
+  for (int n = 1; n <= 70; ++n) {
+    std::vector<int64_t> ref(n);
+    for (auto &v : ref) v = static_cast<int64_t>(rng() % 1000) - 500;
+    IterativeSegmentTree st(ref);
+    for (int it = 0; it < 300; ++it) {
+      int l = static_cast<int>(rng() % n), r = static_cast<int>(rng() % n);
+      if (l > r) std::swap(l, r);
+      if (it % 2 == 0) {
+        const int64_t d = static_cast<int64_t>(rng() % 200) - 100;
+        for (int i = l; i <= r; ++i) ref[i] += d;
+        st.update_range(d, l, r);
+        continue;
+      }
+      const auto first = ref.begin() + l, last = ref.begin() + r + 1;
+      ASSERT_EQ(st.query(l, r), std::accumulate(first, last, int64_t{0}))
+          << "n=" << n << " [" << l << "," << r << "]";
+      ASSERT_EQ(st.query_max(l, r), *std::max_element(first, last))
+          << "n=" << n << " [" << l << "," << r << "]";
+    }
+  }
+}
@@ -0,0 +1,127 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file mpmc_queue_test.cc
+ * @brief A test suite for the MPMC queue.
+ * @author wizyang
+ */
+
+#include "container/mpmc_queue.hpp"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using sdk::container::MPMCQueue;
+
+TEST(MPMCQueueTest, BasicPushPop) {
+  MPMCQueue<int> q(4);
+  EXPECT_EQ(q.capacity(), 4u);
+
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(q.try_push(round * 4 + i));
+    EXPECT_FALSE(q.try_push(-1));
+    EXPECT_EQ(q.size(), 4u);
+    for (int i = 0; i < 4; ++i) {
+      int x = -1;
+      EXPECT_TRUE(q.pop(x));
+      EXPECT_EQ(x, round * 4 + i);
+    }
+    int dummy = 0;
+    EXPECT_FALSE(q.pop(dummy));
+  }
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(MPMCQueueTest, MoveOnlyAndDestroy) {
+  auto token = std::make_shared<int>(0);
+  {
+    MPMCQueue<std::unique_ptr<std::shared_ptr<int>>> q(4);
+    EXPECT_TRUE(q.emplace(std::make_unique<std::shared_ptr<int>>(token)));
+    EXPECT_TRUE(q.emplace(std::make_unique<std::shared_ptr<int>>(token)));
+    std::unique_ptr<std::shared_ptr<int>> out;
+    EXPECT_TRUE(q.pop(out));
+    out.reset();
+    EXPECT_EQ(token.use_count(), 2);
+  }
+  EXPECT_EQ(token.use_count(), 1);
+}
+
+namespace {
+
+// Constructing from a negative value throws
+struct ThrowOnNegative {
+  int value = 0;
+
+  ThrowOnNegative() = default;
+  explicit ThrowOnNegative(int v) : value(v) {
+    if (v < 0) throw std::invalid_argument("negative");
+  }
+};
+
+} // namespace
+
+// A throwing constructor must not leave a claimed cell unpublished
+TEST(MPMCQueueTest, ThrowingConstructorKeepsQueueUsable) {
+  MPMCQueue<ThrowOnNegative> q(4);
+  ASSERT_TRUE(q.emplace(1));
+  EXPECT_THROW(q.emplace(-1), std::invalid_argument);
+  EXPECT_EQ(q.size(), 1u);
+  for (int i = 2; i <= 4; ++i) ASSERT_TRUE(q.emplace(i));
+  EXPECT_FALSE(q.emplace(5));
+
+  ThrowOnNegative out;
+  for (int i = 1; i <= 4; ++i) {
+    ASSERT_TRUE(q.pop(out));
+    EXPECT_EQ(out.value, i);
+  }
+  EXPECT_FALSE(q.pop(out));
+}
+
+TEST(MPMCQueueTest, MPMC_Stress) {
+  const int kProducers = 4;
+  const int kConsumers = 4;
+  const int kPerProducer = 50000;
+  const int kTotal = kProducers * kPerProducer;
+  MPMCQueue<int> q(256);
+
+  std::vector<std::atomic<int>> seen(kTotal);
+  for (auto &s : seen) s.store(0, std::memory_order_relaxed);
+  std::atomic<int> consumed{0};
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < kProducers; ++p) {
+    threads.emplace_back([&q, p] {
+      for (int i = 0; i < kPerProducer; ++i) {
+        while (!q.push(p * kPerProducer + i, 256)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (int c = 0; c < kConsumers; ++c) {
+    threads.emplace_back([&] {
+      int x;
+      while (consumed.load(std::memory_order_relaxed) < kTotal) {
+        if (q.pop(x)) {
+          seen[x].fetch_add(1, std::memory_order_relaxed);
+          consumed.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto &t : threads) t.join();
+
+  EXPECT_EQ(consumed.load(), kTotal);
+  for (int i = 0; i < kTotal; ++i) {
+    ASSERT_EQ(seen[i].load(), 1) << "i=" << i;
+  }
+  EXPECT_TRUE(q.empty());
+}
@@ -0,0 +1,181 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file mpsc_queue_test.cc
+ * @brief A test suite for the MPSC queue.
+ * @author wizyang
+ */
+
+#include "container/mpsc_queue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using sdk::container::FutexWait;
+using sdk::container::MPSCQueue;
+
+TEST(MPSCQueueTest, BasicPushPop) {
+  MPSCQueue<int> q(5);
+  EXPECT_EQ(q.capacity(), 8u);
+  EXPECT_TRUE(q.empty());
+
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_TRUE(q.try_push(i));
+  }
+  EXPECT_FALSE(q.try_push(8));
+  EXPECT_EQ(q.size(), 8u);
+
+  for (int i = 0; i < 8; ++i) {
+    int x = -1;
+    EXPECT_TRUE(q.pop(x));
+    EXPECT_EQ(x, i);
+  }
+  int dummy = 0;
+  EXPECT_FALSE(q.pop(dummy));
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(MPSCQueueTest, PopNWrapAround) {
+  MPSCQueue<int> q(8);
+  int next_in = 0, next_out = 0;
+  for (int round = 0; round < 50; ++round) {
+    for (int i = 0; i < 6; ++i) ASSERT_TRUE(q.try_push(next_in++));
+
+    std::vector<int> out(10, -1);
+    ASSERT_EQ(q.pop_n(out.begin(), out.size()), 6u);
+    for (int i = 0; i < 6; ++i) EXPECT_EQ(out[i], next_out++);
+  }
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(MPSCQueueTest, MoveOnlyAndDestroy) {
+  auto token = std::make_shared<int>(0);
+  {
+    MPSCQueue<std::unique_ptr<std::shared_ptr<int>>> q(4);
+    EXPECT_TRUE(q.emplace(std::make_unique<std::shared_ptr<int>>(token)));
+    EXPECT_TRUE(q.emplace(std::make_unique<std::shared_ptr<int>>(token)));
+    EXPECT_EQ(token.use_count(), 3);
+
+    std::unique_ptr<std::shared_ptr<int>> out;
+    EXPECT_TRUE(q.pop(out));
+    out.reset();
+    EXPECT_EQ(token.use_count(), 2);
+  }
+  EXPECT_EQ(token.use_count(), 1);
+}
+
+namespace {
+
+// Copies throw while armed
+struct ThrowOnCopy {
+  static inline bool armed = false;
+  int value = 0;
+
+  explicit ThrowOnCopy(int v) : value(v) {}
+  ThrowOnCopy(const ThrowOnCopy &other) : value(other.value) {
+    if (armed) throw std::runtime_error("copy");
+  }
+  ThrowOnCopy(ThrowOnCopy &&) noexcept = default;
+  ThrowOnCopy &operator=(const ThrowOnCopy &) = default;
+  ThrowOnCopy &operator=(ThrowOnCopy &&) noexcept = default;
+};
+
+} // namespace
+
+// A throwing constructor must not leave a claimed cell unpublished
+TEST(MPSCQueueTest, ThrowingConstructorKeepsQueueUsable) {
+  MPSCQueue<ThrowOnCopy> q(4);
+  const ThrowOnCopy item(7);
+  ASSERT_TRUE(q.try_push(ThrowOnCopy(1)));
+  ThrowOnCopy::armed = true;
+  EXPECT_THROW(q.try_push(item), std::runtime_error);
+  ThrowOnCopy::armed = false;
+  EXPECT_EQ(q.size(), 1u);
+  ASSERT_TRUE(q.try_push(item));
+
+  ThrowOnCopy out(0);
+  ASSERT_TRUE(q.pop(out));
+  EXPECT_EQ(out.value, 1);
+  ASSERT_TRUE(q.pop(out));
+  EXPECT_EQ(out.value, 7);
+  EXPECT_FALSE(q.pop(out));
+}
+
+TEST(MPSCQueueTest, MPSC_Stress) {
+  const int kProducers = 4;
+  const int kPerProducer = 50000;
+  MPSCQueue<int> q(1024);
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&q, p] {
+      for (int i = 0; i < kPerProducer; ++i) {
+        const int v = p * kPerProducer + i;
+        while (!q.push(v, 256)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // Per-producer FIFO order must hold
+  std::vector<int> last(kProducers, -1);
+  std::vector<int> buf(64);
+  int total = 0;
+  while (total < kProducers * kPerProducer) {
+    const size_t n = q.pop_n(buf.begin(), buf.size());
+    if (n == 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      const int p = buf[i] / kPerProducer;
+      const int seq = buf[i] % kPerProducer;
+      ASSERT_GT(seq, last[p]);
+      last[p] = seq;
+    }
+    total += static_cast<int>(n);
+  }
+
+  for (auto &t : producers) t.join();
+  for (int p = 0; p < kProducers; ++p) {
+    EXPECT_EQ(last[p], kPerProducer - 1);
+  }
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(MPSCQueueTest, FutexParkedConsumer) {
+  const int kProducers = 3;
+  const int kPerProducer = 10000;
+  MPSCQueue<int, FutexWait<>> q(64);
+
+  int x = -1;
+  EXPECT_FALSE(q.pop_wait(x, std::chrono::milliseconds(10)));
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&q] {
+      for (int i = 0; i < kPerProducer; ++i) {
+        ASSERT_TRUE(q.push_wait(i, std::chrono::seconds(10)));
+        if ((i & 0x7FF) == 0) {
+          std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+      }
+    });
+  }
+
+  long long sum = 0;
+  for (int i = 0; i < kProducers * kPerProducer; ++i) {
+    ASSERT_TRUE(q.pop_wait(x, std::chrono::seconds(10)));
+    sum += x;
+  }
+  for (auto &t : producers) t.join();
+  EXPECT_EQ(sum, 1LL * kProducers * kPerProducer * (kPerProducer - 1) / 2);
+}
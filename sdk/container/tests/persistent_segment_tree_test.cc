@@ -0,0 +1,145 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file persistent_segment_tree_test.cc
+ * @brief A test suite for the persistent segment tree.
+ * @author wizyang
+ */
+
+#include "container/persistent_segment_tree.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+
+using sdk::container::MaxOp;
+using sdk::container::NoLazy;
+using sdk::container::PersistentSegmentTree;
+using sdk::container::SumOp;
+
+TEST(PersistentSegmentTreeTest, QueryOldVersions) {
+  std::vector<int> data = {1, 2, 3, 4, 5};
+  PersistentSegmentTree<> st(data);
+  EXPECT_EQ(st.version(), 0u);
+  EXPECT_EQ(st.query(0, 4), 15);
+
+  EXPECT_EQ(st.update_range(2, 1, 3), 1u);  // => [1,4,5,6,5]
+  EXPECT_EQ(st.set(0, 10), 2u);             // => [10,4,5,6,5]
+  EXPECT_EQ(st.update_range(-1, 0, 4), 3u); // => [9,3,4,5,4]
+
+  EXPECT_EQ(st.query(0, 0, 4), 15);
+  EXPECT_EQ(st.query(1, 0, 4), 21);
+  EXPECT_EQ(st.query(2, 0, 4), 30);
+  EXPECT_EQ(st.query(3, 0, 4), 25);
+  EXPECT_EQ(st.query(1, 1, 3), 15);
+  EXPECT_EQ(st.aggregate(1, 0, 4).max, 6);
+  EXPECT_EQ(st.aggregate(3, 0, 4).min, 3);
+  EXPECT_EQ(st.toArray(2), (std::vector<int64_t>{10, 4, 5, 6, 5}));
+
+  // Unknown versions and empty ranges give the identity
+  EXPECT_EQ(st.query(4, 0, 4), 0);
+  EXPECT_EQ(st.query(1, 5, 9), 0);
+}
+
+TEST(PersistentSegmentTreeTest, EmptyRangeUnderLazyAdd) {
+  std::vector<int> data = {1, 2, 3, 4};
+  PersistentSegmentTree<> st(data);
+  st.update_range(5, 0, 3);
+  EXPECT_EQ(st.query(2, 0), 0);
+  EXPECT_EQ(st.aggregate(1, 2, 0).min, INT64_MAX);
+  EXPECT_EQ(st.aggregate(1, 2, 0).max, INT64_MIN);
+  EXPECT_EQ(st.query(-3, -1), 0);
+  EXPECT_EQ(st.query(-5, 9), 30);
+}
+
+TEST(PersistentSegmentTreeTest, UpdateCopiesLogNodes) {
+  std::vector<int64_t> data(1 << 10, 1);
+  PersistentSegmentTree<int64_t, SumOp<int64_t>> st(data);
+  const size_t built = st.node_count();
+  EXPECT_EQ(built, 2u * data.size() - 1);
+
+  st.set(100, 5);
+  EXPECT_EQ(st.node_count() - built, 11u);
+  const size_t before = st.node_count();
+  st.update_range(1, 3, 700);
+  EXPECT_LE(st.node_count() - before, 4u * 11);
+}
+
+TEST(PersistentSegmentTreeTest, ReleaseBefore) {
+  std::vector<int64_t> data(1000, 0);
+  PersistentSegmentTree<> st(data);
+  for (int i = 0; i < 200; ++i) {
+    st.update_range(1, i, 999);
+  }
+  const size_t nodes = st.node_count();
+  const int64_t at_150 = st.query(150, 0, 999);
+
+  st.release_before(150);
+  EXPECT_EQ(st.oldest_version(), 150u);
+  EXPECT_FALSE(st.has_version(149));
+  EXPECT_EQ(st.query(149, 0, 999), 0);
+  EXPECT_EQ(st.query(150, 0, 999), at_150);
+  EXPECT_LT(st.node_count(), nodes);
+
+  // Updates continue on the compacted arena
+  st.update_range(1, 0, 999);
+  EXPECT_EQ(st.version(), 201u);
+  EXPECT_EQ(st.query(0, 0), 2);
+  EXPECT_EQ(st.query(999, 999), 201);
+
+  // The latest version is always kept
+  st.release_before(1000);
+  EXPECT_EQ(st.oldest_version(), 201u);
+  EXPECT_EQ(st.query(998, 999), 402);
+}
+
+// Every version against the array it should hold, across compactions
+TEST(PersistentSegmentTreeTest, RandomAgainstNaive) {
+  std::mt19937 rng(42);
+  const int n = 61;
+  std::vector<int64_t> cur(n);
+  for (auto &v : cur) v = static_cast<int64_t>(rng() % 1000) - 500;
+  PersistentSegmentTree<> st(cur);
+  std::vector<std::vector<int64_t>> history = {cur};
+
+  for (int it = 0; it < 300; ++it) {
+    int l = static_cast<int>(rng() % n), r = static_cast<int>(rng() % n);
+    if (l > r) std::swap(l, r);
+    if (it % 4 == 0) {
+      const int64_t x = static_cast<int64_t>(rng() % 1000);
+      cur[l] = x;
+      st.set(l, x);
+    } else {
+      const int64_t d = static_cast<int64_t>(rng() % 200) - 100;
+      for (int i = l; i <= r; ++i) cur[i] += d;
+      st.update_range(d, l, r);
+    }
+    history.push_back(cur);
+    if (it % 100 == 99) st.release_before(it - 50);
+
+    for (uint64_t v = st.oldest_version(); v <= st.version(); v += 7) {
+      const auto &ref = history[v];
+      int ql = static_cast<int>(rng() % n), qr = static_cast<int>(rng() % n);
+      if (ql > qr) std::swap(ql, qr);
+      const auto first = ref.begin() + ql, last = ref.begin() + qr + 1;
+      const auto stats = st.aggregate(v, ql, qr);
+      ASSERT_EQ(stats.sum, std::accumulate(first, last, int64_t{0}));
+      ASSERT_EQ(stats.min, *std::min_element(first, last));
+      ASSERT_EQ(stats.max, *std::max_element(first, last));
+    }
+  }
+}
+
+TEST(PersistentSegmentTreeTest, OpsWithoutLazy) {
+  std::vector<int64_t> data = {3, 9, 2, 7};
+  PersistentSegmentTree<int64_t, MaxOp<int64_t>, NoLazy<MaxOp<int64_t>>> st(
+      data);
+  st.set(1, 1);
+  st.set(2, 8);
+  EXPECT_EQ(st.query(0, 0, 3), 9);
+  EXPECT_EQ(st.query(1, 0, 3), 7);
+  EXPECT_EQ(st.query(2, 0, 2), 8);
+}
@@ -0,0 +1,76 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file prefix_sum_array_avx2_test.cc
+ * @brief The prefix sum and block sparse table tests built with -mavx2,
+ *        so that the vectorized scans are checked, not only the scalar
+ *        fallbacks.
+ * @author wizyang
+ */
+
+#include "container/prefix_sum_array.h"
+#include "container/sparse_table.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+
+using sdk::container::BlockSparseTable;
+using sdk::container::MaxOp;
+using sdk::container::PrefixSumArray;
+
+namespace {
+
+bool cpuHasAvx2() {
+  return __builtin_cpu_supports("avx2");
+}
+
+} // namespace
+
+TEST(PrefixSumArrayAvx2Test, BuiltWithAvx2) {
+#if !defined(__AVX2__)
+  FAIL() << "this target must be compiled with -mavx2";
+#endif
+}
+
+// Same lengths as PrefixSumArrayTest.AgainstNaive
+TEST(PrefixSumArrayAvx2Test, AgainstNaive) {
+  if (!cpuHasAvx2()) GTEST_SKIP() << "CPU does not support AVX2";
+  std::mt19937 rng(42);
+  for (int n = 1; n <= 37; ++n) {
+    std::vector<int64_t> data(n);
+    for (auto &v : data) v = static_cast<int64_t>(rng() % 2000) - 1000;
+    PrefixSumArray<> ps(data);
+    for (int l = 0; l < n; ++l) {
+      for (int r = l; r < n; ++r) {
+        const auto sum = std::accumulate(data.begin() + l,
+                                         data.begin() + r + 1, int64_t{0});
+        ASSERT_EQ(ps.query(l, r), sum) << n << " " << l << " " << r;
+      }
+    }
+  }
+}
+
+// Queries inside one block go through the vectorized in-block scan
+TEST(PrefixSumArrayAvx2Test, BlockSparseTableInBlock) {
+  if (!cpuHasAvx2()) GTEST_SKIP() << "CPU does not support AVX2";
+  std::mt19937 rng(42);
+  for (int n = 1; n <= 37; ++n) {
+    std::vector<int64_t> data(n);
+    for (auto &v : data) v = static_cast<int64_t>(rng() % 2000) - 1000;
+    BlockSparseTable<> block_min(data);
+    BlockSparseTable<int64_t, MaxOp<int64_t>, 8> block_max(data);
+    for (int l = 0; l < n; ++l) {
+      for (int r = l; r < n; ++r) {
+        const auto first = data.begin() + l, last = data.begin() + r + 1;
+        ASSERT_EQ(block_min.query(l, r), *std::min_element(first, last))
+            << n << " " << l << " " << r;
+        ASSERT_EQ(block_max.query(l, r), *std::max_element(first, last))
+            << n << " " << l << " " << r;
+      }
+    }
+  }
+}
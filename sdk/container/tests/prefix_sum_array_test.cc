@@ -0,0 +1,58 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file prefix_sum_array_test.cc
+ * @brief A test suite for the prefix sum array.
+ * @author wizyang
+ */
+
+#include "container/prefix_sum_array.h"
+
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+
+using sdk::container::PrefixSumArray;
+
+TEST(PrefixSumArrayTest, Basic) {
+  std::vector<int> data = {1, 2, 3, 4, 5};
+  PrefixSumArray<> ps(data);
+  EXPECT_EQ(ps.size(), 5);
+  EXPECT_EQ(ps.query(0, 4), 15);
+  EXPECT_EQ(ps.query(1, 3), 9);
+  EXPECT_EQ(ps.query(2, 2), 3);
+  EXPECT_EQ(ps.prefix_sum(1), 3);
+  EXPECT_EQ(ps.query(3, 100), 9);
+  EXPECT_EQ(ps.query(5, 9), 0);
+  EXPECT_EQ(ps.query(3, 2), 0);
+
+  PrefixSumArray<> empty(std::vector<int>{});
+  EXPECT_EQ(empty.query(0, 0), 0);
+}
+
+TEST(PrefixSumArrayTest, SumDoesNotTruncate) {
+  std::vector<int> data(8, 1 << 30);
+  PrefixSumArray<> ps(data);
+  EXPECT_EQ(ps.query(0, 7), int64_t{1} << 33);
+}
+
+// Every length around the vector width and the scalar tail
+TEST(PrefixSumArrayTest, AgainstNaive) {
+  std::mt19937 rng(42);
+  for (int n = 1; n <= 37; ++n) {
+    std::vector<int64_t> data(n);
+    for (auto &v : data) v = static_cast<int64_t>(rng() % 2000) - 1000;
+    PrefixSumArray<> ps(data);
+    PrefixSumArray<double> psd(data);
+    for (int l = 0; l < n; ++l) {
+      for (int r = l; r < n; ++r) {
+        const auto sum = std::accumulate(data.begin() + l,
+                                         data.begin() + r + 1, int64_t{0});
+        ASSERT_EQ(ps.query(l, r), sum) << n << " " << l << " " << r;
+        ASSERT_DOUBLE_EQ(psd.query(l, r), static_cast<double>(sum));
+      }
+    }
+  }
+}
@@ -12,12 +12,19 @@
 
 #include <chrono>
 
+#include <algorithm>
 #include <atomic>
 #include <gtest/gtest.h>
+#include <iterator>
+#include <optional>
+#include <string>
 #include <thread>
 #include <vector>
 
+using sdk::container::BusySpinWait;
+using sdk::container::FutexWait;
 using sdk::container::SPSCRingbuffer;
+using sdk::container::SpinYieldWait;
 
 struct MoveOnly {
   DISALLOW_COPY(MoveOnly);
@@ -66,6 +73,25 @@ struct CountOps {
   }
 };
 
+// Not default-constructible, move-only, counts live objects
+struct Tracked {
+  DISALLOW_COPY(Tracked);
+  static inline int live{0};
+  int v;
+  std::string s;
+
+  Tracked(int x, std::string str) : v(x), s(std::move(str)) {
+    ++live;
+  }
+  Tracked(Tracked &&rhs) noexcept : v(rhs.v), s(std::move(rhs.s)) {
+    ++live;
+  }
+  Tracked &operator=(Tracked &&) noexcept = default;
+  ~Tracked() {
+    --live;
+  }
+};
+
 TEST(SPSCRingbufferTimeout, BasicPushPopSequence) {
   SPSCRingbuffer<int> rb(8);
   EXPECT_TRUE(rb.empty());
@@ -209,3 +235,239 @@ TEST(SPSCRingbufferTimeout, SPSC_Stress_WithTimeout) {
   }
   EXPECT_TRUE(rb.empty());
 }
+
+TEST(SPSCRingbufferBatch, PushNPopN) {
+  SPSCRingbuffer<int> rb(8);
+  const auto cap = rb.capacity();
+
+  std::vector<int> in(cap + 3);
+  for (size_t i = 0; i < in.size(); ++i) in[i] = static_cast<int>(i);
+
+  // Only capacity elements fit
+  EXPECT_EQ(rb.try_push_n(in.begin(), in.size()), cap);
+  EXPECT_TRUE(rb.full());
+  EXPECT_EQ(rb.try_push_n(in.begin(), 1), 0u);
+
+  std::vector<int> out(cap + 3, -1);
+  EXPECT_EQ(rb.pop_n(out.begin(), 3), 3u);
+  EXPECT_EQ(rb.pop_n(out.begin() + 3, out.size()), cap - 3);
+  EXPECT_EQ(rb.pop_n(out.begin(), 1), 0u);
+  for (size_t i = 0; i < cap; ++i) {
+    EXPECT_EQ(out[i], static_cast<int>(i));
+  }
+  EXPECT_TRUE(rb.empty());
+}
+
+TEST(SPSCRingbufferBatch, WrapAroundSegments) {
+  SPSCRingbuffer<int> rb(8);
+  int next_in = 0, next_out = 0;
+
+  // Offset head/tail so that every batch straddles the end of the storage
+  for (int round = 0; round < 64; ++round) {
+    std::vector<int> in(5);
+    for (auto &x : in) x = next_in++;
+    ASSERT_EQ(rb.try_push_n(in.begin(), in.size()), in.size());
+
+    std::vector<int> out(5, -1);
+    ASSERT_EQ(rb.pop_n(out.begin(), out.size()), out.size());
+    for (auto x : out) EXPECT_EQ(x, next_out++);
+
+    // Mix single element path with batch path
+    ASSERT_TRUE(rb.try_push(next_in++));
+    int x = -1;
+    ASSERT_TRUE(rb.pop(x));
+    EXPECT_EQ(x, next_out++);
+  }
+  EXPECT_TRUE(rb.empty());
+}
+
+TEST(SPSCRingbufferBatch, MoveOnlyType) {
+  SPSCRingbuffer<MoveOnly> rb(4);
+  std::vector<MoveOnly> in;
+  in.emplace_back(1);
+  in.emplace_back(2);
+  EXPECT_EQ(rb.try_push_n(std::make_move_iterator(in.begin()), in.size()), 2u);
+
+  std::vector<MoveOnly> out(2);
+  EXPECT_EQ(rb.pop_n(out.begin(), out.size()), 2u);
+  EXPECT_EQ(out[0].v, 1);
+  EXPECT_EQ(out[1].v, 2);
+}
+
+TEST(SPSCRingbufferBatch, SPSC_Stress_Batch) {
+  const size_t N = 100000;
+  const size_t kBatch = 32;
+  SPSCRingbuffer<int> rb(1024);
+
+  std::vector<int> out;
+  out.reserve(N);
+
+  std::thread prod_th([&] {
+    std::vector<int> buf(kBatch);
+    size_t i = 0;
+    while (i < N) {
+      const size_t n = std::min(kBatch, N - i);
+      for (size_t k = 0; k < n; ++k) buf[k] = static_cast<int>(i + k);
+      size_t done = 0;
+      while (done < n) {
+        done += rb.try_push_n(buf.begin() + done, n - done);
+        if (done < n) std::this_thread::yield();
+      }
+      i += n;
+    }
+  });
+
+  std::thread cons_th([&] {
+    std::vector<int> buf(kBatch);
+    while (out.size() < N) {
+      const size_t n = rb.pop_n(buf.begin(), buf.size());
+      if (n == 0) {
+        std::this_thread::yield();
+        continue;
+      }
+      out.insert(out.end(), buf.begin(), buf.begin() + n);
+    }
+  });
+
+  prod_th.join();
+  cons_th.join();
+
+  ASSERT_EQ(out.size(), N);
+  for (size_t i = 0; i < N; ++i) {
+    EXPECT_EQ(out[i], (int)i);
+  }
+  EXPECT_TRUE(rb.empty());
+}
+
+TEST(SPSCRingbufferPlacement, EmplaceFrontRelease) {
+  Tracked::live = 0;
+  {
+    SPSCRingbuffer<Tracked, true> rb(4);
+    EXPECT_TRUE(rb.emplace(1, "one"));
+    EXPECT_TRUE(rb.emplace(2, "two"));
+    EXPECT_TRUE(rb.try_push(Tracked{3, "three"}));
+    EXPECT_FALSE(rb.emplace(4, "four"));
+    EXPECT_EQ(Tracked::live, 3);
+
+    Tracked *t = rb.front();
+    ASSERT_NE(t, nullptr);
+    EXPECT_EQ(t->v, 1);
+    EXPECT_EQ(t->s, "one");
+    rb.release();
+    EXPECT_EQ(Tracked::live, 2);
+
+    t = rb.front();
+    ASSERT_NE(t, nullptr);
+    EXPECT_EQ(t->v, 2);
+    rb.release();
+    // Leave one element for the destructor
+  }
+  EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(SPSCRingbufferPlacement, ReserveCommit) {
+  Tracked::live = 0;
+  SPSCRingbuffer<Tracked, true> rb(4);
+  for (int round = 0; round < 10; ++round) {
+    Tracked *slot = rb.reserve();
+    ASSERT_NE(slot, nullptr);
+    ::new (static_cast<void *>(slot)) Tracked(round, std::to_string(round));
+    rb.commit();
+
+    Tracked *t = rb.front();
+    ASSERT_NE(t, nullptr);
+    EXPECT_EQ(t->v, round);
+    EXPECT_EQ(t->s, std::to_string(round));
+    rb.release();
+  }
+  EXPECT_EQ(rb.front(), nullptr);
+  EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(SPSCRingbufferPlacement, ReserveCommitInPlaceDefaultMode) {
+  SPSCRingbuffer<CountOps> rb(4);
+  CountOps::Reset();
+
+  CountOps *slot = rb.reserve();
+  ASSERT_NE(slot, nullptr);
+  slot->v = 42;
+  rb.commit();
+
+  CountOps *t = rb.front();
+  ASSERT_NE(t, nullptr);
+  EXPECT_EQ(t->v, 42);
+  rb.release();
+  EXPECT_TRUE(rb.empty());
+
+  EXPECT_EQ(CountOps::copies.load(), 0);
+  EXPECT_EQ(CountOps::moves.load(), 0);
+}
+
+TEST(SPSCRingbufferPlacement, PopAndBatch) {
+  Tracked::live = 0;
+  {
+    SPSCRingbuffer<Tracked, true> rb(8);
+    std::vector<Tracked> in;
+    for (int i = 0; i < 5; ++i) in.emplace_back(i, "x");
+    EXPECT_EQ(rb.try_push_n(std::make_move_iterator(in.begin()), in.size()),
+              5u);
+
+    Tracked out{-1, ""};
+    EXPECT_TRUE(rb.pop(out));
+    EXPECT_EQ(out.v, 0);
+
+    std::vector<Tracked> outs;
+    for (int i = 0; i < 4; ++i) outs.emplace_back(-1, "");
+    EXPECT_EQ(rb.pop_n(outs.begin(), outs.size()), 4u);
+    for (int i = 0; i < 4; ++i) EXPECT_EQ(outs[i].v, i + 1);
+    EXPECT_TRUE(rb.empty());
+  }
+  EXPECT_EQ(Tracked::live, 0);
+}
+
+template <typename Wait>
+class SPSCRingbufferWait : public ::testing::Test {};
+
+using WaitStrategies =
+    ::testing::Types<BusySpinWait, SpinYieldWait<>, FutexWait<>>;
+TYPED_TEST_SUITE(SPSCRingbufferWait, WaitStrategies);
+
+TYPED_TEST(SPSCRingbufferWait, TimeoutWhenEmptyOrFull) {
+  SPSCRingbuffer<int, false, TypeParam> rb(4);
+  int x = -1;
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(rb.pop_wait(x, std::chrono::milliseconds(20)));
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(20));
+
+  for (size_t i = 0; i < rb.capacity(); ++i) {
+    EXPECT_TRUE(rb.push_wait((int)i, std::chrono::milliseconds(1)));
+  }
+  EXPECT_FALSE(rb.push_wait(99, std::chrono::milliseconds(20)));
+
+  EXPECT_TRUE(rb.pop_wait(x, std::chrono::milliseconds(1)));
+  EXPECT_EQ(x, 0);
+}
+
+TYPED_TEST(SPSCRingbufferWait, WakeOnPush) {
+  const int N = 20000;
+  SPSCRingbuffer<int, false, TypeParam> rb(16);
+
+  std::thread cons_th([&] {
+    for (int i = 0; i < N; ++i) {
+      int x = -1;
+      ASSERT_TRUE(rb.pop_wait(x, std::chrono::seconds(10)));
+      ASSERT_EQ(x, i);
+    }
+  });
+
+  for (int i = 0; i < N; ++i) {
+    ASSERT_TRUE(rb.push_wait(i, std::chrono::seconds(10)));
+    // Let the consumer go idle from time to time
+    if ((i & 0x3FF) == 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+  }
+  cons_th.join();
+  EXPECT_TRUE(rb.empty());
+}
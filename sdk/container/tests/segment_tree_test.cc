@@ -9,12 +9,22 @@
  */
 
 #include "container/segment_tree.h"
+#include "executor/thread_pool.h"
 
+#include <cerrno>
+#include <cstdio>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 #include <numeric>
+#include <random>
+#include <string>
+#include <unistd.h>
 
+using sdk::container::MaxOp;
+using sdk::container::MinOp;
+using sdk::container::NoLazy;
 using sdk::container::SegmentTree;
+using sdk::container::SumOp;
 
 TEST(SegmentTreeTest, BasicQuery) {
   std::vector<int> data = {1, 2, 3, 4, 5};
@@ -85,3 +95,297 @@ TEST(SegmentTreeBugTest, LazyPushDownTrigger) {
   int result = seg.query(1, 3);
   EXPECT_EQ(result, 18) << "Lazy propagation parameter issue triggered!";
 }
+
+TEST(SegmentTreeTest, SumDoesNotTruncate) {
+  std::vector<int64_t> data(4, int64_t{1} << 40);
+  SegmentTree st(data);
+  EXPECT_EQ(st.query(0, 3), int64_t{1} << 42);
+
+  st.update_range(int64_t{1} << 40, 0, 3);
+  EXPECT_EQ(st.query(0, 3), int64_t{1} << 43);
+}
+
+TEST(SegmentTreeTest, MinMaxUnderLazyAdd) {
+  std::vector<int> data = {5, 1, 4, 2, 3};
+  SegmentTree st(data);
+  EXPECT_EQ(st.query_min(0, 4), 1);
+  EXPECT_EQ(st.query_max(0, 4), 5);
+
+  st.update_range(10, 1, 2); // => [5,11,14,2,3]
+  EXPECT_EQ(st.query_min(0, 4), 2);
+  EXPECT_EQ(st.query_max(0, 4), 14);
+  EXPECT_EQ(st.query_max(0, 1), 11);
+  EXPECT_EQ(st.query_min(2, 3), 2);
+
+  st.update_range(-20, 0, 4); // => [-15,-9,-6,-18,-17]
+  EXPECT_EQ(st.query_min(0, 4), -18);
+  EXPECT_EQ(st.query_max(1, 2), -6);
+  EXPECT_EQ(st.query(0, 4), -65);
+}
+
+// Inverted and out of range bounds under a pending tag are empty, on the
+// recursive and the batched path alike
+TEST(SegmentTreeTest, EmptyRangeUnderLazyAdd) {
+  std::vector<int> data = {1, 2, 3, 4};
+  SegmentTree st(data);
+  st.update_range(5, 0, 3);
+  EXPECT_EQ(st.query(2, 0), 0);
+  EXPECT_EQ(st.query_min(2, 0), INT64_MAX);
+  EXPECT_EQ(st.query_max(2, 0), INT64_MIN);
+  EXPECT_EQ(st.query(3, 1), 0);
+  EXPECT_EQ(st.query(-3, -1), 0);
+  EXPECT_EQ(st.query(4, 9), 0);
+  EXPECT_EQ(st.query(-5, 9), 30);
+
+  const std::vector<std::pair<int, int>> queries = {{2, 0}, {3, 1}, {0, 3}};
+  std::vector<int64_t> out(queries.size());
+  st.query_batch(queries, out);
+  EXPECT_EQ(out, (std::vector<int64_t>{0, 0, 30}));
+}
+
+TEST(SegmentTreeTest, RandomAgainstNaive) {
+  std::mt19937 rng(42);
+  const int n = 97;
+  std::vector<int64_t> ref(n);
+  for (auto &v : ref) v = static_cast<int64_t>(rng() % 1000) - 500;
+  SegmentTree st(ref);
+  SegmentTree<int64_t, MinOp<int64_t>> min_tree(ref);
+  SegmentTree<int64_t, SumOp<int64_t>> sum_tree(ref);
+
+  for (int it = 0; it < 2000; ++it) {
+    int l = static_cast<int>(rng() % n), r = static_cast<int>(rng() % n);
+    if (l > r) std::swap(l, r);
+    if (it % 3 == 0) {
+      const int64_t d = static_cast<int64_t>(rng() % 200) - 100;
+      for (int i = l; i <= r; ++i) ref[i] += d;
+      st.update_range(d, l, r);
+      min_tree.update_range(d, l, r);
+      sum_tree.update_range(d, l, r);
+      continue;
+    }
+    const auto first = ref.begin() + l, last = ref.begin() + r + 1;
+    const int64_t sum = std::accumulate(first, last, int64_t{0});
+    ASSERT_EQ(st.query(l, r), sum);
+    ASSERT_EQ(sum_tree.query(l, r), sum);
+    ASSERT_EQ(st.query_min(l, r), *std::min_element(first, last));
+    ASSERT_EQ(st.query_max(l, r), *std::max_element(first, last));
+    ASSERT_EQ(min_tree.query(l, r), *std::min_element(first, last));
+  }
+}
+
+namespace {
+
+// Custom aggregate: leftmost element, to check the combine order
+struct FirstOp {
+  using value_type = int64_t;
+  using result_type = int64_t;
+  static int64_t identity() {
+    return -1;
+  }
+  static int64_t leaf(int64_t x) {
+    return x;
+  }
+  static int64_t combine(int64_t a, int64_t b) {
+    return a != -1 ? a : b;
+  }
+  static int64_t result(int64_t v) {
+    return v;
+  }
+};
+
+// Custom aggregate: greatest common divisor, point updates only
+struct GcdOp {
+  using value_type = int64_t;
+  using result_type = int64_t;
+  static int64_t identity() {
+    return 0;
+  }
+  static int64_t leaf(int64_t x) {
+    return x;
+  }
+  static int64_t combine(int64_t a, int64_t b) {
+    return std::gcd(a, b);
+  }
+  static int64_t result(int64_t v) {
+    return v;
+  }
+};
+
+} // namespace
+
+TEST(SegmentTreeTest, CustomOpWithPointSet) {
+  std::vector<int64_t> data = {12, 18, 24, 36};
+  SegmentTree<int64_t, GcdOp, NoLazy<GcdOp>> st(data);
+  EXPECT_EQ(st.query(0, 3), 6);
+  st.set(1, 8);
+  EXPECT_EQ(st.query(0, 3), 4);
+  EXPECT_EQ(st.query(2, 3), 12);
+
+  // set() after a range add on a lazy tree keeps the other elements intact
+  SegmentTree<int64_t, MaxOp<int64_t>> max_tree(data);
+  max_tree.update_range(100, 0, 3);
+  max_tree.set(3, 0);
+  EXPECT_EQ(max_tree.query(0, 3), 124);
+  EXPECT_EQ(max_tree.query(3, 3), 0);
+}
+
+TEST(SegmentTreeTest, QueryBatchMatchesQuery) {
+  std::mt19937 rng(7);
+  for (int n = 1; n <= 70; ++n) {
+    std::vector<int64_t> data(n);
+    for (auto &v : data) v = static_cast<int64_t>(rng() % 1000) - 500;
+    SegmentTree st(data);
+    SegmentTree<int64_t, MinOp<int64_t>> min_tree(data);
+    std::vector<int64_t> ids(n);
+    std::iota(ids.begin(), ids.end(), 0);
+    SegmentTree<int64_t, FirstOp, NoLazy<FirstOp>> first_tree(ids);
+
+    // Pending tags at several depths
+    for (int i = 0; i < 5; ++i) {
+      int l = static_cast<int>(rng() % n), r = static_cast<int>(rng() % n);
+      if (l > r) std::swap(l, r);
+      const int64_t d = static_cast<int64_t>(rng() % 200) - 100;
+      st.update_range(d, l, r);
+      min_tree.update_range(d, l, r);
+    }
+
+    // Random ranges plus clipped and empty ones
+    std::vector<std::pair<int, int>> queries;
+    for (int i = 0; i < 50; ++i) {
+      int l = static_cast<int>(rng() % n), r = static_cast<int>(rng() % n);
+      if (l > r) std::swap(l, r);
+      queries.emplace_back(l, r);
+    }
+    queries.emplace_back(-3, n + 3);
+    queries.emplace_back(n, n + 5);
+    queries.emplace_back(2, 1);
+
+    std::vector<int64_t> sums(queries.size()), mins(queries.size()),
+        firsts(queries.size());
+    st.query_batch(queries, sums);
+    min_tree.query_batch(queries, mins);
+    first_tree.query_batch(queries, firsts);
+    for (size_t i = 0; i < queries.size(); ++i) {
+      const auto [l, r] = queries[i];
+      ASSERT_EQ(sums[i], st.query(l, r)) << "n=" << n << " i=" << i;
+      ASSERT_EQ(mins[i], min_tree.query(l, r)) << "n=" << n << " i=" << i;
+      ASSERT_EQ(firsts[i], first_tree.query(l, r)) << "n=" << n << " i=" << i;
+    }
+  }
+}
+
+TEST(SegmentTreeTest, QueryBatchOnThreadPool) {
+  std::mt19937 rng(11);
+  const int n = 10007;
+  std::vector<int64_t> data(n);
+  for (auto &v : data) v = static_cast<int64_t>(rng() % 1000);
+  SegmentTree st(data);
+  st.update_range(3, 100, 9000);
+
+  std::vector<std::pair<int, int>> queries(20000);
+  for (auto &q : queries) {
+    int l = static_cast<int>(rng() % n), r = static_cast<int>(rng() % n);
+    q = {std::min(l, r), std::max(l, r)};
+  }
+  std::vector<int64_t> serial(queries.size()), parallel(queries.size());
+  st.query_batch(queries, serial);
+
+  sdk::executor::ThreadPool pool(4);
+  st.query_batch(queries, parallel, pool, 1000);
+  EXPECT_EQ(serial, parallel);
+  EXPECT_EQ(serial[0], st.query(queries[0].first, queries[0].second));
+}
+
+namespace {
+
+std::string SnapshotPath(const char *name) {
+  return ::testing::TempDir() + "/" + name + "." + std::to_string(::getpid());
+}
+
+} // namespace
+
+TEST(SegmentTreeTest, SnapshotRoundTrip) {
+  std::mt19937 rng(3);
+  std::vector<int64_t> data(1000);
+  for (auto &v : data) v = static_cast<int64_t>(rng() % 1000) - 500;
+  SegmentTree st(data);
+  st.update_range(7, 100, 600); // pending tags go into the file too
+  const std::string path = SnapshotPath("segment_tree_snapshot");
+  ASSERT_TRUE(st.save(path));
+
+  auto mapped = SegmentTree<>::open_mmap(path, true);
+  ASSERT_NE(mapped, nullptr);
+  EXPECT_TRUE(mapped->mapped());
+  EXPECT_EQ(mapped->size(), st.size());
+  EXPECT_EQ(mapped->toArray(), st.toArray());
+  EXPECT_EQ(mapped->query_min(0, 999), st.query_min(0, 999));
+
+  // Updates stay in private pages, the file keeps the saved state
+  mapped->update_range(-3, 0, 999);
+  mapped->set(5, 42);
+  auto expect = st.toArray();
+  for (auto &v : expect) v -= 3;
+  expect[5] = 42;
+  EXPECT_EQ(mapped->toArray(), expect);
+  auto reopened = SegmentTree<>::open_mmap(path);
+  ASSERT_NE(reopened, nullptr);
+  EXPECT_EQ(reopened->toArray(), st.toArray());
+
+  // A copy owns its nodes and outlives the mapping
+  SegmentTree<> copy = *mapped;
+  mapped.reset();
+  EXPECT_FALSE(copy.mapped());
+  EXPECT_EQ(copy.query(5, 5), 42);
+  ::unlink(path.c_str());
+}
+
+TEST(SegmentTreeTest, SnapshotRejectsBadFiles) {
+  std::vector<int64_t> data(300, 1);
+  SegmentTree st(data);
+  const std::string path = SnapshotPath("segment_tree_bad");
+  ASSERT_TRUE(st.save(path));
+
+  // Different node types
+  EXPECT_EQ((SegmentTree<int64_t, MaxOp<int64_t>>::open_mmap(path)), nullptr);
+  EXPECT_EQ(errno, EINVAL);
+
+  // Same node and tag sizes, different ops or element type
+  using SumTree = SegmentTree<int64_t, SumOp<int64_t>>;
+  SumTree sum_tree(data);
+  ASSERT_TRUE(sum_tree.save(path));
+  EXPECT_NE(SumTree::open_mmap(path), nullptr);
+  EXPECT_EQ((SegmentTree<int64_t, MaxOp<int64_t>>::open_mmap(path)), nullptr);
+  EXPECT_EQ(errno, EINVAL);
+  EXPECT_EQ((SegmentTree<int64_t, MinOp<int64_t>>::open_mmap(path)), nullptr);
+  EXPECT_EQ(errno, EINVAL);
+  EXPECT_EQ((SegmentTree<double, SumOp<double>>::open_mmap(path)), nullptr);
+  EXPECT_EQ(errno, EINVAL);
+  ASSERT_TRUE(st.save(path));
+
+  auto patch = [&](long offset, unsigned char byte) {
+    FILE *f = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(f, nullptr);
+    std::fseek(f, offset, SEEK_SET);
+    std::fputc(byte, f);
+    std::fclose(f);
+  };
+
+  // A node flipped: only a verifying open notices
+  patch(4096 + 24, 0x7f);
+  EXPECT_NE(SegmentTree<>::open_mmap(path), nullptr);
+  EXPECT_EQ(SegmentTree<>::open_mmap(path, true), nullptr);
+  EXPECT_EQ(errno, EBADMSG);
+
+  // Header fields are always checked
+  ASSERT_TRUE(st.save(path));
+  patch(32, 0x01); // size
+  EXPECT_EQ(SegmentTree<>::open_mmap(path), nullptr);
+  ASSERT_TRUE(st.save(path));
+  patch(0, 'X'); // magic
+  EXPECT_EQ(SegmentTree<>::open_mmap(path), nullptr);
+  EXPECT_EQ(errno, EINVAL);
+
+  ::unlink(path.c_str());
+  EXPECT_EQ(SegmentTree<>::open_mmap(path), nullptr);
+  EXPECT_EQ(errno, ENOENT);
+}
@@ -0,0 +1,148 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file shm_ringbuffer_test.cc
+ * @brief A test suite for the shared memory SPSC ring buffer.
+ * @author wizyang
+ */
+
+#include "container/shm_ringbuffer.hpp"
+
+#include <cerrno>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using sdk::container::ShmRingHeader;
+using sdk::container::ShmRole;
+using sdk::container::ShmSegment;
+using sdk::container::ShmSPSCRingbuffer;
+
+struct Tick {
+  uint64_t seq;
+  double px;
+};
+
+static std::string UniqueName(const char *tag) {
+  return "/sdk_shm_test_" + std::string(tag) + "_" + std::to_string(::getpid());
+}
+
+TEST(ShmSPSCRingbufferTest, CreateAttachPushPop) {
+  const auto name = UniqueName("basic");
+  auto prod = ShmSPSCRingbuffer<Tick>::Create(name, 5, ShmRole::kProducer);
+  ASSERT_NE(prod, nullptr) << errno;
+  EXPECT_EQ(prod->capacity(), 8u);
+
+  // Name is taken
+  EXPECT_EQ(ShmSPSCRingbuffer<Tick>::Create(name, 8, ShmRole::kProducer),
+            nullptr);
+  EXPECT_EQ(errno, EEXIST);
+
+  auto cons = ShmSPSCRingbuffer<Tick>::Attach(name, ShmRole::kConsumer);
+  ASSERT_NE(cons, nullptr) << errno;
+  EXPECT_TRUE(prod->peer_alive());
+  EXPECT_TRUE(cons->peer_alive());
+
+  for (uint64_t i = 0; i < 8; ++i) {
+    EXPECT_TRUE(prod->try_push(Tick{i, 1.5 * i}));
+  }
+  EXPECT_FALSE(prod->try_push(Tick{8, 0}));
+  EXPECT_EQ(cons->size(), 8u);
+
+  for (uint64_t i = 0; i < 8; ++i) {
+    Tick t{};
+    EXPECT_TRUE(cons->pop(t));
+    EXPECT_EQ(t.seq, i);
+    EXPECT_DOUBLE_EQ(t.px, 1.5 * i);
+  }
+  Tick t{};
+  EXPECT_FALSE(cons->pop(t));
+
+  // Zero-copy path
+  Tick *slot = prod->reserve();
+  ASSERT_NE(slot, nullptr);
+  slot->seq = 42;
+  prod->commit();
+  const Tick *in = cons->front();
+  ASSERT_NE(in, nullptr);
+  EXPECT_EQ(in->seq, 42u);
+  cons->release();
+
+  EXPECT_TRUE(ShmSegment::Unlink(name));
+}
+
+TEST(ShmSPSCRingbufferTest, RejectsMismatchAndBusyRole) {
+  const auto name = UniqueName("mismatch");
+  auto prod = ShmSPSCRingbuffer<Tick>::Create(name, 8, ShmRole::kProducer);
+  ASSERT_NE(prod, nullptr);
+
+  // Different element type
+  EXPECT_EQ(ShmSPSCRingbuffer<uint32_t>::Attach(name, ShmRole::kConsumer),
+            nullptr);
+  EXPECT_EQ(errno, EPROTO);
+
+  // Different layout version
+  auto seg = ShmSegment::Open(name);
+  ASSERT_NE(seg, nullptr);
+  auto *h = static_cast<ShmRingHeader *>(seg->data());
+  h->version += 1;
+  EXPECT_EQ(ShmSPSCRingbuffer<Tick>::Attach(name, ShmRole::kConsumer),
+            nullptr);
+  EXPECT_EQ(errno, EPROTO);
+  h->version -= 1;
+
+  // Producer role is owned by a live process (the parent of this test)
+  h->producer_pid.store(static_cast<int32_t>(::getppid()));
+  EXPECT_EQ(ShmSPSCRingbuffer<Tick>::Attach(name, ShmRole::kProducer),
+            nullptr);
+  EXPECT_EQ(errno, EBUSY);
+
+  EXPECT_TRUE(ShmSegment::Unlink(name));
+}
+
+TEST(ShmSPSCRingbufferTest, TwoProcessesAndLiveness) {
+  const uint64_t N = 200000;
+  auto prod = ShmSPSCRingbuffer<Tick>::CreateAnonymous(1024, ShmRole::kProducer);
+  ASSERT_NE(prod, nullptr);
+  EXPECT_FALSE(prod->peer_alive());
+
+  const pid_t child = ::fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    auto cons = ShmSPSCRingbuffer<Tick>::AttachFd(prod->fd(), ShmRole::kConsumer);
+    if (!cons) ::_exit(2);
+    for (uint64_t i = 0; i < N; ++i) {
+      Tick t{};
+      while (!cons->pop(t)) {
+        if (!cons->peer_alive()) ::_exit(3);
+      }
+      if (t.seq != i) ::_exit(4);
+    }
+    ::_exit(0);
+  }
+
+  for (uint64_t i = 0; i < N; ++i) {
+    while (!prod->try_push(Tick{i, 0.0})) {
+    }
+  }
+
+  int status = 0;
+  ASSERT_EQ(::waitpid(child, &status, 0), child);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+
+  // Child exited without detaching, the consumer role is free to take over
+  EXPECT_FALSE(prod->peer_alive());
+  auto cons = ShmSPSCRingbuffer<Tick>::AttachFd(prod->fd(), ShmRole::kConsumer);
+  ASSERT_NE(cons, nullptr);
+  EXPECT_TRUE(prod->peer_alive());
+  EXPECT_TRUE(cons->empty());
+
+  cons.reset();
+  EXPECT_FALSE(prod->peer_alive());
+}
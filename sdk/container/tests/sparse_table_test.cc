@@ -0,0 +1,84 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file sparse_table_test.cc
+ * @brief A test suite for the static range min/max tables.
+ * @author wizyang
+ */
+
+#include "container/sparse_table.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+
+using sdk::container::BlockSparseTable;
+using sdk::container::MaxOp;
+using sdk::container::MinOp;
+using sdk::container::SparseTable;
+
+TEST(SparseTableTest, Basic) {
+  std::vector<int> data = {5, 1, 4, 2, 3, 9, 0, 7};
+  SparseTable<> min_table(data);
+  SparseTable<int64_t, MaxOp<int64_t>> max_table(data);
+  EXPECT_EQ(min_table.size(), 8);
+  EXPECT_EQ(min_table.query(0, 7), 0);
+  EXPECT_EQ(min_table.query(0, 5), 1);
+  EXPECT_EQ(min_table.query(2, 4), 2);
+  EXPECT_EQ(min_table.query(3, 3), 2);
+  EXPECT_EQ(max_table.query(0, 4), 5);
+  EXPECT_EQ(max_table.query(1, 7), 9);
+
+  // Clipped and empty ranges
+  EXPECT_EQ(min_table.query(-5, 100), 0);
+  EXPECT_EQ(min_table.query(8, 9), INT64_MAX);
+  EXPECT_EQ(max_table.query(3, 2), INT64_MIN);
+
+  SparseTable<> empty(std::vector<int>{});
+  EXPECT_EQ(empty.size(), 0);
+  EXPECT_EQ(empty.query(0, 0), INT64_MAX);
+}
+
+TEST(SparseTableTest, BlockQueriesSpanningBlocks) {
+  std::vector<int64_t> data(100);
+  for (int i = 0; i < 100; ++i) data[i] = 1000 - i * 3 + (i % 7) * 11;
+  BlockSparseTable<int64_t, MinOp<int64_t>, 8> st(data);
+  // Inside one block, two adjacent blocks and several blocks
+  EXPECT_EQ(st.query(2, 6), *std::min_element(&data[2], &data[7]));
+  EXPECT_EQ(st.query(5, 12), *std::min_element(&data[5], &data[13]));
+  EXPECT_EQ(st.query(3, 90), *std::min_element(&data[3], &data[91]));
+  EXPECT_EQ(st.query(0, 99), *std::min_element(data.begin(), data.end()));
+  EXPECT_EQ(st.query(100, 120), INT64_MAX);
+}
+
+// Every range of every n up to 150 against a linear scan
+TEST(SparseTableTest, AllRangesAgainstNaive) {
+  std::mt19937 rng(42);
+  for (int n = 1; n <= 150; n += (n < 40 ? 1 : 13)) {
+    std::vector<int64_t> data(n);
+    for (auto &v : data) v = static_cast<int64_t>(rng() % 2000) - 1000;
+    SparseTable<> sparse_min(data);
+    BlockSparseTable<> block_min(data);
+    BlockSparseTable<int64_t, MaxOp<int64_t>, 4> block_max(data);
+    for (int l = 0; l < n; ++l) {
+      for (int r = l; r < n; ++r) {
+        const auto first = data.begin() + l, last = data.begin() + r + 1;
+        const int64_t lo = *std::min_element(first, last);
+        const int64_t hi = *std::max_element(first, last);
+        ASSERT_EQ(sparse_min.query(l, r), lo) << n << " " << l << " " << r;
+        ASSERT_EQ(block_min.query(l, r), lo) << n << " " << l << " " << r;
+        ASSERT_EQ(block_max.query(l, r), hi) << n << " " << l << " " << r;
+      }
+    }
+  }
+}
+
+TEST(SparseTableTest, BlockMemoryIsLinear) {
+  std::vector<int64_t> data(1 << 16, 1);
+  SparseTable<> sparse(data);
+  BlockSparseTable<> block(data);
+  EXPECT_GE(sparse.memory_usage(), data.size() * sizeof(int64_t) * 15);
+  EXPECT_LE(block.memory_usage(), data.size() * sizeof(int64_t) * 4);
+}
@@ -0,0 +1,114 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file unbounded_spsc_queue_test.cc
+ * @brief A test suite for the unbounded chunked SPSC queue.
+ * @author wizyang
+ */
+
+#include "container/unbounded_spsc_queue.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using sdk::container::UnboundedSPSCQueue;
+
+TEST(UnboundedSPSCQueueTest, GrowsAcrossChunks) {
+  UnboundedSPSCQueue<int, 4> q;
+  EXPECT_EQ(q.capacity(), 4u);
+  EXPECT_TRUE(q.empty());
+  EXPECT_FALSE(q.full());
+
+  for (int i = 0; i < 10; ++i) EXPECT_TRUE(q.try_push(i));
+  EXPECT_EQ(q.size(), 10u);
+  EXPECT_EQ(q.capacity(), 12u);
+
+  for (int i = 0; i < 10; ++i) {
+    int x = -1;
+    EXPECT_TRUE(q.pop(x));
+    EXPECT_EQ(x, i);
+  }
+  int dummy = 0;
+  EXPECT_FALSE(q.pop(dummy));
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(UnboundedSPSCQueueTest, RecyclesChunksWithoutAllocating) {
+  UnboundedSPSCQueue<int, 4> q;
+  // Grow to three chunks once, then stay below that high-water mark
+  for (int i = 0; i < 12; ++i) q.try_push(i);
+  int x = 0;
+  while (q.pop(x)) {
+  }
+  const size_t high = q.capacity();
+
+  for (int round = 0; round < 100; ++round) {
+    for (int i = 0; i < 8; ++i) EXPECT_TRUE(q.try_push(round * 8 + i));
+    for (int i = 0; i < 8; ++i) {
+      EXPECT_TRUE(q.pop(x));
+      EXPECT_EQ(x, round * 8 + i);
+    }
+  }
+  EXPECT_EQ(q.capacity(), high);
+
+  // trim() returns the spare chunks, the active one stays
+  EXPECT_GT(q.trim(), 0u);
+  EXPECT_EQ(q.capacity(), 4u);
+  EXPECT_TRUE(q.try_push(7));
+  EXPECT_TRUE(q.pop(x));
+  EXPECT_EQ(x, 7);
+}
+
+TEST(UnboundedSPSCQueueTest, ReserveBatchAndDestroy) {
+  auto token = std::make_shared<int>(0);
+  {
+    UnboundedSPSCQueue<std::shared_ptr<int>, 2> q(6);
+    EXPECT_EQ(q.capacity(), 6u);
+
+    std::shared_ptr<int> *slot = q.reserve();
+    // Not committed yet, a second reserve() returns the same slot
+    EXPECT_EQ(q.reserve(), slot);
+    ::new (static_cast<void *>(slot)) std::shared_ptr<int>(token);
+    q.commit();
+
+    std::vector<std::shared_ptr<int>> in(5, token);
+    EXPECT_EQ(q.try_push_n(in.begin(), in.size()), 5u);
+    in.clear();
+    EXPECT_EQ(token.use_count(), 7);
+
+    std::vector<std::shared_ptr<int>> out(3);
+    EXPECT_EQ(q.pop_n(out.begin(), 3), 3u);
+    out.clear();
+    EXPECT_EQ(token.use_count(), 4);
+    EXPECT_NE(q.front(), nullptr);
+    q.release();
+    EXPECT_EQ(token.use_count(), 3);
+  }
+  EXPECT_EQ(token.use_count(), 1);
+}
+
+TEST(UnboundedSPSCQueueTest, BurstyProducerConsumer) {
+  const int kBursts = 50;
+  const int kBurst = 5000;
+  UnboundedSPSCQueue<std::string, 64> q;
+
+  std::thread consumer([&] {
+    std::string s;
+    for (int i = 0; i < kBursts * kBurst; ++i) {
+      ASSERT_TRUE(q.pop_wait(s, std::chrono::seconds(10)));
+      ASSERT_EQ(s, std::to_string(i));
+    }
+  });
+  for (int b = 0; b < kBursts; ++b) {
+    for (int i = 0; i < kBurst; ++i) q.emplace(std::to_string(b * kBurst + i));
+    std::this_thread::yield();
+  }
+  consumer.join();
+  EXPECT_TRUE(q.empty());
+}
@@ -0,0 +1,100 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file work_stealing_deque_test.cc
+ * @brief A test suite for the Chase-Lev work-stealing deque.
+ * @author wizyang
+ */
+
+#include "container/work_stealing_deque.hpp"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using sdk::container::WorkStealingDeque;
+
+TEST(WorkStealingDequeTest, OwnerLifoThiefFifo) {
+  WorkStealingDeque<int> dq(4);
+  for (int i = 0; i < 4; ++i) dq.push(i);
+  EXPECT_EQ(dq.size(), 4u);
+
+  int x = -1;
+  EXPECT_TRUE(dq.pop(x));
+  EXPECT_EQ(x, 3);
+  EXPECT_TRUE(dq.steal(x));
+  EXPECT_EQ(x, 0);
+  EXPECT_TRUE(dq.steal(x));
+  EXPECT_EQ(x, 1);
+  EXPECT_TRUE(dq.pop(x));
+  EXPECT_EQ(x, 2);
+  EXPECT_FALSE(dq.pop(x));
+  EXPECT_FALSE(dq.steal(x));
+  EXPECT_TRUE(dq.empty());
+}
+
+TEST(WorkStealingDequeTest, GrowsKeepingOrder) {
+  WorkStealingDeque<int> dq(2);
+  int x = 0;
+  // Move top_ away from zero so the copy has to wrap
+  dq.push(-1);
+  EXPECT_TRUE(dq.steal(x));
+
+  for (int i = 0; i < 100; ++i) dq.push(i);
+  EXPECT_GE(dq.capacity(), 100u);
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_TRUE(dq.steal(x));
+    EXPECT_EQ(x, i);
+  }
+  for (int i = 99; i >= 50; --i) {
+    EXPECT_TRUE(dq.pop(x));
+    EXPECT_EQ(x, i);
+  }
+  EXPECT_FALSE(dq.pop(x));
+}
+
+TEST(WorkStealingDequeTest, EveryItemTakenOnce) {
+  const int kItems = 200000;
+  const int kThieves = 3;
+  WorkStealingDeque<int> dq(64);
+  std::vector<std::atomic<int>> seen(kItems);
+  std::atomic<bool> done{false};
+  std::atomic<int> taken{0};
+
+  std::vector<std::thread> thieves;
+  for (int i = 0; i < kThieves; ++i) {
+    thieves.emplace_back([&] {
+      int x;
+      while (!done.load(std::memory_order_acquire)) {
+        if (dq.steal(x)) {
+          seen[x].fetch_add(1, std::memory_order_relaxed);
+          taken.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // Owner interleaves pushes and pops, the array grows under the thieves
+  int x;
+  for (int i = 0; i < kItems; ++i) {
+    dq.push(i);
+    if (i % 3 == 0 && dq.pop(x)) {
+      seen[x].fetch_add(1, std::memory_order_relaxed);
+      taken.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  while (dq.pop(x)) {
+    seen[x].fetch_add(1, std::memory_order_relaxed);
+    taken.fetch_add(1, std::memory_order_relaxed);
+  }
+  while (taken.load() < kItems) std::this_thread::yield();
+  done.store(true, std::memory_order_release);
+  for (auto &t : thieves) t.join();
+
+  for (int i = 0; i < kItems; ++i) ASSERT_EQ(seen[i].load(), 1) << i;
+}
@@ -0,0 +1,115 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file thread_pool.h
+ * @brief A work-stealing thread pool.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "container/work_stealing_deque.hpp"
+#include "macro/macros.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sdk {
+namespace executor {
+
+// Work-stealing thread pool
+//
+// Every worker owns a Chase-Lev deque. Tasks submitted from a worker go to
+// its own deque (LIFO, cache-warm); tasks submitted from other threads go to
+// a shared injection queue. An idle worker drains its deque, then the
+// injection queue, then steals from randomly chosen victims, and finally
+// parks on a condition variable until new work is submitted.
+//
+// Exceptions thrown by submit()ed tasks are logged and dropped; parallel_for
+// rethrows the first one on the calling thread.
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+  // body(begin, end) handles the half-open index range [begin, end)
+  using RangeBody = std::function<void(size_t, size_t)>;
+
+  /*
+   * @brief Start the workers
+   * @param size_t threads, 0 means std::thread::hardware_concurrency()
+   */
+  explicit ThreadPool(size_t threads = 0);
+
+  // Runs every task already submitted, then joins the workers
+  ~ThreadPool();
+
+  DISALLOW_COPY_AND_MOVE(ThreadPool);
+
+  void submit(Task task);
+
+  /*
+   * @brief Submit many tasks with a single wake-up of the idle workers
+   */
+  void bulk_submit(std::vector<Task> tasks);
+
+  /*
+   * @brief Split [begin, end) into chunks of grain indices and run body on
+   *        them in parallel. The caller runs tasks too while it waits, so it
+   *        is safe to call from inside a task.
+   * @param size_t grain, 0 picks about four chunks per worker
+   */
+  void parallel_for(size_t begin, size_t end, const RangeBody &body,
+                    size_t grain = 0);
+
+  size_t size() const {
+    return workers_.size();
+  }
+
+  // True when called from one of this pool's workers
+  bool in_worker() const;
+
+ private:
+  struct Worker {
+    container::WorkStealingDeque<Task *> deque;
+    std::thread thread;
+    uint64_t rng;
+  };
+
+  void run(size_t index);
+  // Take a task for worker self (size() for a non-worker thread)
+  Task *find(size_t self);
+  bool run_one(size_t self);
+  void execute(Task *task);
+  void enqueue(Task *task);
+  void wake(bool all);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  std::mutex inject_mu_;
+  std::deque<Task *> inject_;
+  std::atomic<size_t> inject_size_{0};
+
+  // Tasks queued anywhere and not yet taken
+  std::atomic<size_t> pending_{0};
+
+  // Parking: epoch_ moves on every submit so a worker that searched before
+  // the submit does not go to sleep after it
+  std::mutex park_mu_;
+  std::condition_variable park_cv_;
+  std::atomic<uint64_t> epoch_{0};
+  std::atomic<size_t> sleepers_{0};
+  std::atomic<bool> stop_{false};
+};
+
+} // namespace executor
+} // namespace sdk
@@ -0,0 +1,225 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file thread_pool.cc
+ * @brief A work-stealing thread pool.
+ * @author wizyang
+ */
+
+#include "executor/thread_pool.h"
+
+#include "log/log.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace sdk {
+namespace executor {
+
+namespace {
+
+// The pool and worker index of the current thread, if it is a worker
+thread_local const ThreadPool *t_pool = nullptr;
+thread_local size_t t_index = 0;
+
+uint64_t next_random(uint64_t &state) {
+  // xorshift64
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  workers_.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    workers_.emplace_back(new Worker{});
+    workers_.back()->rng = 0x9e3779b97f4a7c15ULL * (i + 1);
+  }
+  // Start only once every deque exists, workers steal from each other
+  for (size_t i = 0; i < threads; ++i) {
+    workers_[i]->thread = std::thread([this, i] { run(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lk(park_mu_);
+    stop_.store(true);
+  }
+  park_cv_.notify_all();
+  for (auto &w : workers_) {
+    w->thread.join();
+  }
+}
+
+bool ThreadPool::in_worker() const {
+  return t_pool == this;
+}
+
+void ThreadPool::submit(Task task) {
+  enqueue(new Task(std::move(task)));
+  wake(false);
+}
+
+void ThreadPool::bulk_submit(std::vector<Task> tasks) {
+  if (tasks.empty()) return;
+  if (in_worker()) {
+    for (auto &t : tasks) enqueue(new Task(std::move(t)));
+  } else {
+    // One lock for the whole batch
+    std::lock_guard<std::mutex> lk(inject_mu_);
+    for (auto &t : tasks) inject_.push_back(new Task(std::move(t)));
+    pending_.fetch_add(tasks.size());
+    inject_size_.store(inject_.size(), std::memory_order_release);
+  }
+  wake(tasks.size() > 1);
+}
+
+void ThreadPool::parallel_for(size_t begin, size_t end, const RangeBody &body,
+                              size_t grain) {
+  if (begin >= end) return;
+  const size_t n = end - begin;
+  if (grain == 0) {
+    grain = std::max<size_t>(1, n / (workers_.size() * 4));
+  }
+  const size_t chunks = (n + grain - 1) / grain;
+  if (chunks == 1) {
+    body(begin, end);
+    return;
+  }
+
+  std::atomic<size_t> remaining{chunks};
+  std::mutex err_mu;
+  std::exception_ptr err;
+
+  std::vector<Task> tasks;
+  tasks.reserve(chunks);
+  for (size_t lo = begin; lo < end; lo += grain) {
+    const size_t hi = std::min(end, lo + grain);
+    tasks.emplace_back([&, lo, hi] {
+      try {
+        body(lo, hi);
+      } catch (...) {
+        std::lock_guard<std::mutex> lk(err_mu);
+        if (!err) err = std::current_exception();
+      }
+      remaining.fetch_sub(1, std::memory_order_acq_rel);
+    });
+  }
+  bulk_submit(std::move(tasks));
+
+  // Help instead of blocking, a worker calling parallel_for must not starve
+  // the pool of its own thread
+  const size_t self = in_worker() ? t_index : workers_.size();
+  while (remaining.load(std::memory_order_acquire) != 0) {
+    if (!run_one(self)) {
+      std::this_thread::yield();
+    }
+  }
+  if (err) std::rethrow_exception(err);
+}
+
+void ThreadPool::run(size_t index) {
+  t_pool = this;
+  t_index = index;
+  while (true) {
+    const uint64_t epoch = epoch_.load();
+    if (run_one(index)) continue;
+    if (stop_.load() && pending_.load() == 0) break;
+
+    std::unique_lock<std::mutex> lk(park_mu_);
+    sleepers_.fetch_add(1);
+    // Pairs with wake(): either we see the new epoch here or the submitter
+    // sees sleepers_ != 0 and notifies
+    park_cv_.wait(lk, [&] {
+      return epoch_.load() != epoch || stop_.load();
+    });
+    sleepers_.fetch_sub(1);
+  }
+  t_pool = nullptr;
+}
+
+ThreadPool::Task *ThreadPool::find(size_t self) {
+  Task *task = nullptr;
+  if (self < workers_.size() && workers_[self]->deque.pop(task)) {
+    return task;
+  }
+
+  if (inject_size_.load(std::memory_order_acquire) != 0) {
+    std::lock_guard<std::mutex> lk(inject_mu_);
+    if (!inject_.empty()) {
+      task = inject_.front();
+      inject_.pop_front();
+      inject_size_.store(inject_.size(), std::memory_order_release);
+      return task;
+    }
+  }
+
+  // Random victim first, then everyone else once
+  const size_t n = workers_.size();
+  thread_local uint64_t rng = 0x2545f4914f6cdd1dULL;
+  uint64_t &state = self < n ? workers_[self]->rng : rng;
+  const size_t start = static_cast<size_t>(next_random(state) % n);
+  for (size_t i = 0; i < n; ++i) {
+    const size_t victim = (start + i) % n;
+    if (victim != self && workers_[victim]->deque.steal(task)) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+bool ThreadPool::run_one(size_t self) {
+  Task *task = find(self);
+  if (!task) return false;
+  pending_.fetch_sub(1);
+  execute(task);
+  return true;
+}
+
+void ThreadPool::execute(Task *task) {
+  try {
+    (*task)();
+  } catch (const std::exception &e) {
+    LOG(ERROR) << "[EXECUTOR] task threw: " << e.what();
+  } catch (...) {
+    LOG(ERROR) << "[EXECUTOR] task threw an unknown exception";
+  }
+  delete task;
+}
+
+void ThreadPool::enqueue(Task *task) {
+  pending_.fetch_add(1);
+  if (in_worker()) {
+    workers_[t_index]->deque.push(task);
+    return;
+  }
+  std::lock_guard<std::mutex> lk(inject_mu_);
+  inject_.push_back(task);
+  inject_size_.store(inject_.size(), std::memory_order_release);
+}
+
+void ThreadPool::wake(bool all) {
+  epoch_.fetch_add(1);
+  if (sleepers_.load() == 0) return;
+  {
+    // Serialize with a worker between its predicate check and its wait
+    std::lock_guard<std::mutex> lk(park_mu_);
+  }
+  if (all) {
+    park_cv_.notify_all();
+  } else {
+    park_cv_.notify_one();
+  }
+}
+
+} // namespace executor
+} // namespace sdk
@@ -0,0 +1,122 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file thread_pool_test.cc
+ * @brief A test suite for the work-stealing thread pool.
+ * @author wizyang
+ */
+
+#include "executor/thread_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using sdk::executor::ThreadPool;
+
+TEST(ThreadPoolTest, SubmitRunsEveryTask) {
+  std::atomic<int> count{0};
+  {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4u);
+    EXPECT_FALSE(pool.in_worker());
+    for (int i = 0; i < 10000; ++i) {
+      pool.submit([&] { count.fetch_add(1, std::memory_order_relaxed); });
+    }
+  }
+  // The destructor drains the queues before joining
+  EXPECT_EQ(count.load(), 10000);
+}
+
+TEST(ThreadPoolTest, NestedSubmitAndBulk) {
+  std::atomic<int> count{0};
+  {
+    ThreadPool pool(3);
+    std::vector<ThreadPool::Task> tasks;
+    for (int i = 0; i < 100; ++i) {
+      tasks.emplace_back([&] {
+        EXPECT_TRUE(pool.in_worker());
+        // Lands on the worker's own deque, other workers steal it
+        for (int j = 0; j < 10; ++j) {
+          pool.submit([&] { count.fetch_add(1, std::memory_order_relaxed); });
+        }
+      });
+    }
+    pool.bulk_submit(std::move(tasks));
+  }
+  EXPECT_EQ(count.load(), 1000);
+}
+
+TEST(ThreadPoolTest, ParallelForCoversRangeOnce) {
+  ThreadPool pool(4);
+  std::vector<int> hits(100003, 0);
+  pool.parallel_for(0, hits.size(), [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) ++hits[i];
+  });
+  for (size_t i = 0; i < hits.size(); ++i) ASSERT_EQ(hits[i], 1) << i;
+
+  // Fixed grain and an offset range
+  std::atomic<long> sum{0};
+  pool.parallel_for(
+      10, 1010,
+      [&](size_t lo, size_t hi) {
+        EXPECT_LE(hi - lo, 7u);
+        long s = 0;
+        for (size_t i = lo; i < hi; ++i) s += static_cast<long>(i);
+        sum.fetch_add(s);
+      },
+      7);
+  EXPECT_EQ(sum.load(), (10L + 1009L) * 1000 / 2);
+}
+
+TEST(ThreadPoolTest, NestedParallelForDoesNotDeadlock) {
+  ThreadPool pool(2);
+  std::atomic<int> count{0};
+  pool.parallel_for(
+      0, 8,
+      [&](size_t, size_t) {
+        pool.parallel_for(
+            0, 100,
+            [&](size_t lo, size_t hi) {
+              count.fetch_add(static_cast<int>(hi - lo));
+            },
+            10);
+      },
+      1);
+  EXPECT_EQ(count.load(), 800);
+}
+
+TEST(ThreadPoolTest, ParallelForRethrows) {
+  ThreadPool pool(2);
+  EXPECT_THROW(pool.parallel_for(
+                   0, 100,
+                   [](size_t lo, size_t) {
+                     if (lo == 50) throw std::runtime_error("boom");
+                   },
+                   10),
+               std::runtime_error);
+
+  // A throwing task does not take its worker down
+  std::atomic<bool> ran{false};
+  pool.submit([] { throw std::runtime_error("ignored"); });
+  pool.submit([&] { ran = true; });
+  while (!ran.load()) std::this_thread::yield();
+}
+
+TEST(ThreadPoolTest, IdleWorkersParkAndWake) {
+  ThreadPool pool(4);
+  std::atomic<int> count{0};
+  for (int round = 0; round < 20; ++round) {
+    // Let every worker go to sleep before the next submit
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    pool.submit([&] { count.fetch_add(1); });
+    while (count.load() != round + 1) std::this_thread::yield();
+  }
+  EXPECT_EQ(count.load(), 20);
+}
@@ -0,0 +1,59 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file byte_search.h
+ * @brief Vectorized byte pattern search for frame codecs.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace sdk {
+namespace net {
+
+/*
+ * @brief Index of the first a immediately followed by b in [p, p + n)
+ * @return size_t, n when there is none. A trailing a without the byte after
+ *         it is not a match.
+ *
+ * With SSE2, 16 positions are tested per step by comparing the block at i
+ * with a and the block at i + 1 with b. The tail, and targets without SSE2,
+ * jump between candidates with memchr.
+ */
+inline size_t findBytePair(const uint8_t *p, size_t n, uint8_t a, uint8_t b) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i va = _mm_set1_epi8(static_cast<char>(a));
+  const __m128i vb = _mm_set1_epi8(static_cast<char>(b));
+  for (; i + 17 <= n; i += 16) {
+    const __m128i x =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+    const __m128i y =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i + 1));
+    const int mask = _mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(x, va), _mm_cmpeq_epi8(y, vb)));
+    if (mask != 0) return i + __builtin_ctz(mask);
+  }
+#endif
+  while (i + 1 < n) {
+    const void *hit = std::memchr(p + i, a, n - 1 - i);
+    if (hit == nullptr) break;
+    i = static_cast<size_t>(static_cast<const uint8_t *>(hit) - p);
+    if (p[i + 1] == b) return i;
+    ++i;
+  }
+  return n;
+}
+
+} // namespace net
+} // namespace sdk
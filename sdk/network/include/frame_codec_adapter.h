@@ -0,0 +1,117 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file frame_codec_adapter.h
+ * @brief IFrameCodec on top of a compile-time FrameCodec.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "network/frame_codec_base.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sdk {
+namespace net {
+
+// Virtual codec for sessions, with the framing of C inlined
+//
+// The view path (decodeView()/decodeBatch()) frames in place in the
+// session's receive buffer, decodeBatch() decodes a whole read with one
+// virtual call. The buffered path (append()/tryDecode()) keeps the stream
+// in buf_ from head_ on and drops consumed bytes once they are at least
+// half of the buffer, so each byte is moved at most once. A session uses
+// one path or the other, they share the state of C.
+template <FrameCodec C>
+class FrameCodecAdapter : public IFrameCodec {
+ public:
+  template <typename... Args>
+  explicit FrameCodecAdapter(Args &&...args)
+      : codec_(std::forward<Args>(args)...) {}
+
+  void append(const uint8_t *data, size_t len) override {
+    if (head_ == buf_.size()) {
+      buf_.clear();
+      head_ = 0;
+    } else if (head_ > 0 && head_ >= buf_.size() / 2) {
+      buf_.erase(buf_.begin(), buf_.begin() + head_);
+      head_ = 0;
+    }
+    buf_.insert(buf_.end(), data, data + len);
+  }
+
+  std::optional<std::vector<uint8_t>> tryDecode() override {
+    while (true) {
+      const FrameView frame = codec_.decode(
+          std::span<const uint8_t>(buf_.data() + head_, buf_.size() - head_));
+      head_ += frame.consumed;
+      if (frame.payload) {
+        return std::vector<uint8_t>(frame.payload->begin(),
+                                    frame.payload->end());
+      }
+      if (frame.consumed == 0) return std::nullopt;
+    }
+  }
+
+  bool supportsView() const override {
+    return true;
+  }
+
+  FrameView decodeView(std::span<const uint8_t> data) override {
+    return codec_.decode(data);
+  }
+
+  size_t decodeBatch(std::span<const uint8_t> data, FrameSink sink) override {
+    return decodeFrames(codec_, data, sink);
+  }
+
+  /*
+   * @brief payload as one frame
+   */
+  std::vector<uint8_t> encode(std::span<const uint8_t> payload) const {
+    std::vector<uint8_t> out;
+    codec_.encode(payload, out);
+    return out;
+  }
+
+  C &codec() noexcept {
+    return codec_;
+  }
+
+ private:
+  C codec_;
+  std::vector<uint8_t> buf_;
+  // Start of the bytes not decoded yet
+  size_t head_ = 0;
+};
+
+/*
+ * @brief CodecFactory for TcpServer/TcpClient::setCodecFactory() making a
+ *        Codec per session from copies of args. A FrameCodec is wrapped in
+ *        FrameCodecAdapter, an IFrameCodec is used as is.
+ */
+template <typename Codec, typename... Args>
+std::function<std::unique_ptr<IFrameCodec>()> makeCodecFactory(Args... args) {
+  return [args...]() -> std::unique_ptr<IFrameCodec> {
+    if constexpr (std::is_base_of_v<IFrameCodec, Codec>) {
+      return std::make_unique<Codec>(args...);
+    } else {
+      return std::make_unique<FrameCodecAdapter<Codec>>(args...);
+    }
+  };
+}
+
+} // namespace net
+} // namespace sdk
@@ -12,9 +12,12 @@
 
 #include <cstdint>
 
+#include <concepts>
 #include <functional>
 #include <optional>
+#include <span>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace sdk {
@@ -22,10 +25,113 @@ namespace net {
 
 class IFrameCodec {
  public:
+  // Result of decodeView(): consumed bytes at the front of the input are
+  // done with (skipped garbage and the frame), payload points into the
+  // input when a whole frame was there
+  struct FrameView {
+    size_t consumed = 0;
+    std::optional<std::span<const uint8_t>> payload;
+  };
+
   virtual ~IFrameCodec() = default;
   virtual void append(const uint8_t *data, size_t n) = 0;
   virtual std::optional<std::vector<uint8_t>> tryDecode() = 0;
+
+  /*
+   * @brief Whether decodeView() is implemented. Sessions then frame in
+   *        place in their receive buffer, instead of append()/tryDecode()
+   */
+  virtual bool supportsView() const {
+    return false;
+  }
+
+  /*
+   * @brief Find the next frame at the front of data without copying it.
+   *        Unconsumed bytes are passed again, with more after them.
+   */
+  virtual FrameView decodeView(std::span<const uint8_t> /*data*/) {
+    return {};
+  }
+
+  // Non-owning reference to the callback of decodeBatch(): one indirect
+  // call per frame, no allocation
+  class FrameSink {
+   public:
+    template <typename Fn>
+      requires(!std::same_as<std::remove_cvref_t<Fn>, FrameSink>)
+    FrameSink(Fn &fn) noexcept // NOLINT
+        : obj_(&fn), call_([](void *obj, std::span<const uint8_t> payload) {
+            (*static_cast<Fn *>(obj))(payload);
+          }) {}
+
+    void operator()(std::span<const uint8_t> payload) const {
+      call_(obj_, payload);
+    }
+
+   private:
+    void *obj_;
+    void (*call_)(void *, std::span<const uint8_t>);
+  };
+
+  /*
+   * @brief Pass every complete frame at the front of data to sink, for
+   *        codecs with decodeView(). Template codecs override it with an
+   *        inlined loop, so a read costs one virtual call, not one per frame.
+   * @return size_t, bytes consumed
+   */
+  virtual size_t decodeBatch(std::span<const uint8_t> data, FrameSink sink) {
+    size_t consumed = 0;
+    while (true) {
+      const FrameView frame = decodeView(data.subspan(consumed));
+      consumed += frame.consumed;
+      if (frame.payload) {
+        sink(*frame.payload);
+      } else if (frame.consumed == 0) {
+        return consumed;
+      }
+    }
+  }
+};
+
+using FrameView = IFrameCodec::FrameView;
+
+// Compile-time codec: the framing without buffering or virtual calls
+//
+//   FrameView decode(std::span<const uint8_t> data);
+//     the next frame at the front of data, like IFrameCodec::decodeView().
+//     Bytes not consumed are passed again with more after them, so a codec
+//     may remember how far it already searched.
+//   void encode(std::span<const uint8_t> payload,
+//               std::vector<uint8_t> &out) const;
+//     append payload as one frame to out
+//
+// FrameCodecAdapter turns one into an IFrameCodec for the sessions.
+template <typename C>
+concept FrameCodec = requires(C &codec, const C &ccodec,
+                              std::span<const uint8_t> data,
+                              std::vector<uint8_t> &out) {
+  { codec.decode(data) } -> std::same_as<FrameView>;
+  ccodec.encode(data, out);
 };
 
+/*
+ * @brief Call fn(std::span<const uint8_t>) for every complete frame at the
+ *        front of data, payloads point into data
+ * @return size_t, bytes consumed
+ */
+template <FrameCodec C, typename Fn>
+size_t decodeFrames(C &codec, std::span<const uint8_t> data, Fn &&fn) {
+  size_t consumed = 0;
+  while (true) {
+    const FrameView frame = codec.decode(data.subspan(consumed));
+    consumed += frame.consumed;
+    if (frame.payload) {
+      fn(*frame.payload);
+    } else if (frame.consumed == 0) {
+      return consumed;
+    }
+  }
+}
+
 } // namespace net
 } // namespace sdk
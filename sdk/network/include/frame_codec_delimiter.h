@@ -0,0 +1,95 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file frame_codec_delimiter.h
+ * @brief Delimiter-terminated framing, e.g. lines.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "network/byte_search.h"
+#include "network/frame_codec_base.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sdk {
+namespace net {
+
+// Frames are the payload followed by a delimiter ("\n" by default, "\r\n"
+// for text protocols), payloads must not contain it. A FrameCodec, see
+// FrameCodecAdapter.
+//
+// The delimiter is found with memchr for one byte and with findBytePair()
+// on its first two bytes otherwise. A partial frame is not searched again
+// when more bytes arrive: the search resumes where the last one stopped.
+class DelimiterCodec {
+ public:
+  explicit DelimiterCodec(std::string delimiter = "\n")
+      : delimiter_(std::move(delimiter)) {
+    if (delimiter_.empty()) delimiter_ = "\n";
+  }
+
+  FrameView decode(std::span<const uint8_t> data) {
+    const size_t pos = find(data);
+    if (pos == data.size()) {
+      // the last bytes may be the start of a delimiter
+      const size_t keep = delimiter_.size() - 1;
+      searched_ = data.size() > keep ? data.size() - keep : 0;
+      return {};
+    }
+    searched_ = 0;
+    return {pos + delimiter_.size(), data.subspan(0, pos)};
+  }
+
+  void encode(std::span<const uint8_t> payload,
+              std::vector<uint8_t> &out) const {
+    out.insert(out.end(), payload.begin(), payload.end());
+    out.insert(out.end(), delimiter_.begin(), delimiter_.end());
+  }
+
+  const std::string &delimiter() const noexcept {
+    return delimiter_;
+  }
+
+ private:
+  // Start of the first whole delimiter in data from searched_ on, or
+  // data.size()
+  size_t find(std::span<const uint8_t> data) const {
+    const auto *d = reinterpret_cast<const uint8_t *>(delimiter_.data());
+    const size_t dlen = delimiter_.size();
+    const uint8_t *p = data.data();
+    const size_t n = data.size();
+    size_t i = std::min(searched_, n);
+    if (i == n) return n;
+    if (dlen == 1) {
+      const void *hit = std::memchr(p + i, d[0], n - i);
+      return hit ? static_cast<const uint8_t *>(hit) - p : n;
+    }
+    while (i + dlen <= n) {
+      i += findBytePair(p + i, n - i, d[0], d[1]);
+      if (i + dlen > n) break;
+      if (std::memcmp(p + i + 2, d + 2, dlen - 2) == 0) return i;
+      ++i;
+    }
+    return n;
+  }
+
+  std::string delimiter_;
+  // Bytes at the front of the pending data known not to start a delimiter
+  size_t searched_ = 0;
+};
+
+} // namespace net
+} // namespace sdk
@@ -0,0 +1,114 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file frame_codec_length.h
+ * @brief Length-prefixed framing: fixed width and varint.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "network/frame_codec_base.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <bit>
+#include <limits>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace sdk {
+namespace net {
+
+// Frames are the payload length as a Length (1, 2, 4 or 8 bytes) in Order,
+// then the payload. A FrameCodec, see FrameCodecAdapter.
+//
+//   server->setCodecFactory(makeCodecFactory<LengthPrefixCodec<uint16_t>>());
+template <typename Length = uint32_t, std::endian Order = std::endian::big>
+class LengthPrefixCodec {
+ public:
+  static_assert(std::is_unsigned_v<Length> && !std::is_same_v<Length, bool>,
+                "Length must be uint8_t, uint16_t, uint32_t or uint64_t");
+  static_assert(Order == std::endian::big || Order == std::endian::little);
+
+  static constexpr size_t kHeaderSize = sizeof(Length);
+
+  FrameView decode(std::span<const uint8_t> data) const {
+    if (data.size() < kHeaderSize) return {};
+    const uint64_t len = load(data.data());
+    if (data.size() - kHeaderSize < len) return {};
+    return {kHeaderSize + len, data.subspan(kHeaderSize, len)};
+  }
+
+  /*
+   * @brief Append payload as one frame to out. A payload longer than Length
+   *        can hold is not representable and appends nothing.
+   */
+  void encode(std::span<const uint8_t> payload,
+              std::vector<uint8_t> &out) const {
+    if (payload.size() > std::numeric_limits<Length>::max()) return;
+    const auto len = static_cast<Length>(payload.size());
+    for (size_t i = 0; i < kHeaderSize; ++i) {
+      const size_t shift =
+          8 * (Order == std::endian::big ? kHeaderSize - 1 - i : i);
+      out.push_back(static_cast<uint8_t>(len >> shift));
+    }
+    out.insert(out.end(), payload.begin(), payload.end());
+  }
+
+ private:
+  // Byte by byte, compilers turn it into a load and a bswap when needed
+  static uint64_t load(const uint8_t *p) noexcept {
+    uint64_t v = 0;
+    for (size_t i = 0; i < kHeaderSize; ++i) {
+      const size_t shift =
+          8 * (Order == std::endian::big ? kHeaderSize - 1 - i : i);
+      v |= uint64_t(p[i]) << shift;
+    }
+    return v;
+  }
+};
+
+// Frames are the payload length as an unsigned LEB128 varint (7 bits per
+// byte, low group first, high bit set on all but the last byte, as in
+// protobuf), then the payload. A varint longer than 10 bytes or over 64
+// bits is dropped as garbage. A FrameCodec, see FrameCodecAdapter.
+class VarintLengthCodec {
+ public:
+  static constexpr size_t kMaxHeaderSize = 10;
+
+  FrameView decode(std::span<const uint8_t> data) const {
+    uint64_t len = 0;
+    size_t i = 0;
+    for (;; ++i) {
+      if (i == data.size()) return {}; // header incomplete
+      const uint8_t b = data[i];
+      // the 10th byte only has room for bit 63
+      if (i == kMaxHeaderSize - 1 && b > 1) return {i + 1, std::nullopt};
+      len |= uint64_t(b & 0x7F) << (7 * i);
+      if ((b & 0x80) == 0) break;
+    }
+    const size_t header = i + 1;
+    if (data.size() - header < len) return {};
+    return {header + len, data.subspan(header, len)};
+  }
+
+  void encode(std::span<const uint8_t> payload,
+              std::vector<uint8_t> &out) const {
+    uint64_t len = payload.size();
+    while (len >= 0x80) {
+      out.push_back(static_cast<uint8_t>(len | 0x80));
+      len >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(len));
+    out.insert(out.end(), payload.begin(), payload.end());
+  }
+};
+
+} // namespace net
+} // namespace sdk
@@ -10,12 +10,16 @@
 
 #pragma once
 
+#include "network/byte_search.h"
+#include "network/frame_codec_adapter.h"
 #include "network/frame_codec_base.h"
 
 #include <cstdint>
 #include <cstring>
 
+#include <bit>
 #include <optional>
+#include <span>
 #include <vector>
 
 namespace sdk {
@@ -29,42 +33,38 @@ constexpr bool isBigEndian() {
   return std::endian::native == std::endian::big;
 }
 
-class SimpleMagicCodec : public IFrameCodec {
+// Frames are magic 0xABCD, a 4-byte payload length, then the payload, all
+// big endian. Bytes before a magic are skipped: resync searches the magic
+// with findBytePair() instead of stepping one byte at a time. A FrameCodec,
+// see FrameCodecAdapter.
+class MagicFrameCodec {
  public:
   static constexpr uint16_t kMagic = 0xABCD; // 2 bytes
-
-  void append(const uint8_t *data, size_t len) override {
-    buf_.insert(buf_.end(), data, data + len);
-  }
-
-  std::optional<std::vector<uint8_t>> tryDecode() override {
-    while (true) {
-      if (buf_.size() < 6) return std::nullopt; // header incomplete
-
-      // ---- parse magic ----
-      uint16_t magic = (uint16_t(buf_[0]) << 8) | (uint16_t(buf_[1]) << 0);
-      if (magic != kMagic) {
-        buf_.erase(buf_.begin());
-        continue;
-      }
-
-      // ---- parse length ----
-      uint32_t len = (uint32_t(buf_[2]) << 24) | (uint32_t(buf_[3]) << 16) |
-                     (uint32_t(buf_[4]) << 8) | (uint32_t(buf_[5]));
-      if (buf_.size() < 6 + len) return std::nullopt;
-
-      // ---- extract payload ----
-      std::vector<uint8_t> out(buf_.begin() + 6, buf_.begin() + 6 + len);
-
-      // ---- remove used bytes ----
-      buf_.erase(buf_.begin(), buf_.begin() + 6 + len);
-      return out;
+  static constexpr size_t kHeaderSize = 6;
+
+  FrameView decode(std::span<const uint8_t> data) const {
+    const uint8_t *p = data.data();
+    const size_t n = data.size();
+    const size_t skip =
+        findBytePair(p, n, uint8_t(kMagic >> 8), uint8_t(kMagic & 0xFF));
+    if (skip == n) {
+      // no magic, but a last 0xAB may be the start of one
+      const bool partial = n > 0 && p[n - 1] == uint8_t(kMagic >> 8);
+      return {n - partial, std::nullopt};
     }
+    if (n - skip < kHeaderSize) return {skip, std::nullopt};
+
+    const uint8_t *h = p + skip;
+    uint32_t len = (uint32_t(h[2]) << 24) | (uint32_t(h[3]) << 16) |
+                   (uint32_t(h[4]) << 8) | (uint32_t(h[5]));
+    if (n - skip - kHeaderSize < len) return {skip, std::nullopt};
+    return {skip + kHeaderSize + len, data.subspan(skip + kHeaderSize, len)};
   }
 
-  std::vector<uint8_t> encode(const uint8_t *data, size_t len) {
-    std::vector<uint8_t> out;
-    out.reserve(6 + len);
+  void encode(std::span<const uint8_t> payload,
+              std::vector<uint8_t> &out) const {
+    const size_t len = payload.size();
+    out.reserve(out.size() + kHeaderSize + len);
 
     // magic (big endian)
     out.push_back(uint8_t((kMagic >> 8) & 0xFF));
@@ -77,13 +77,21 @@ class SimpleMagicCodec : public IFrameCodec {
     out.push_back(uint8_t((len >> 0) & 0xFF));
 
     // payload
-    out.insert(out.end(), data, data + len);
-
-    return out;
+    out.insert(out.end(), payload.begin(), payload.end());
   }
+};
 
- private:
-  std::vector<uint8_t> buf_;
+// MagicFrameCodec as an IFrameCodec, for setCodecFactory()
+class SimpleMagicCodec : public FrameCodecAdapter<MagicFrameCodec> {
+ public:
+  static constexpr uint16_t kMagic = MagicFrameCodec::kMagic;
+  static constexpr size_t kHeaderSize = MagicFrameCodec::kHeaderSize;
+
+  using FrameCodecAdapter::encode;
+
+  std::vector<uint8_t> encode(const uint8_t *data, size_t len) const {
+    return encode(std::span<const uint8_t>(data, len));
+  }
 };
 
 } // namespace net
@@ -0,0 +1,98 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file message_view.h
+ * @brief Zero-copy views of received messages.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace sdk {
+namespace net {
+
+// A received message that keeps its storage alive, see MessageView::retain()
+class RetainedMessage {
+ public:
+  RetainedMessage() = default;
+  RetainedMessage(std::span<const uint8_t> data,
+                  std::shared_ptr<const void> owner)
+      : data_(data), owner_(std::move(owner)) {}
+
+  std::span<const uint8_t> data() const noexcept {
+    return data_;
+  }
+
+  size_t size() const noexcept {
+    return data_.size();
+  }
+
+  bool empty() const noexcept {
+    return data_.empty();
+  }
+
+  void reset() noexcept {
+    data_ = {};
+    owner_.reset();
+  }
+
+ private:
+  std::span<const uint8_t> data_;
+  std::shared_ptr<const void> owner_;
+};
+
+// A received message as a view into the session's receive buffer, without
+// a copy. The bytes are only valid during the handler call: the buffer is
+// reused by the next read. retain() keeps the buffer alive instead, the
+// session then reads into a new one, so a retained message costs a buffer
+// but still no copy.
+class MessageView {
+ public:
+  MessageView(std::span<const uint8_t> data,
+              const std::shared_ptr<const void> &owner) noexcept
+      : data_(data), owner_(&owner) {}
+
+  std::span<const uint8_t> data() const noexcept {
+    return data_;
+  }
+
+  const uint8_t *begin() const noexcept {
+    return data_.data();
+  }
+
+  const uint8_t *end() const noexcept {
+    return data_.data() + data_.size();
+  }
+
+  size_t size() const noexcept {
+    return data_.size();
+  }
+
+  bool empty() const noexcept {
+    return data_.empty();
+  }
+
+  /*
+   * @brief Keep the bytes valid after the handler returns, from any thread
+   */
+  RetainedMessage retain() const {
+    return RetainedMessage(data_, *owner_);
+  }
+
+ private:
+  std::span<const uint8_t> data_;
+  // Not copied unless retained, so a plain view costs no refcount update
+  const std::shared_ptr<const void> *owner_;
+};
+
+} // namespace net
+} // namespace sdk
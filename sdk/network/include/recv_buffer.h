@@ -0,0 +1,159 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file recv_buffer.h
+ * @brief A session's reference-counted, reusable receive buffer.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include "network/frame_codec_base.h"
+#include "network/message_view.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace sdk {
+namespace net {
+
+// Receive buffer that sockets read into and messages are viewed in place
+//
+// Bytes are appended at the end by reads and consumed from the front by
+// decoding; an incomplete frame stays pending until the next read. When the
+// tail runs short, the pending bytes are moved to the front, or the buffer
+// grows when a frame does not fit. A MessageView::retain() holds a
+// reference to the storage, and while one is alive the buffer never writes
+// over consumed bytes: it reads into a fresh allocation instead.
+//
+// Only the session's thread uses it, retained messages may be released on
+// any thread.
+class RecvBuffer {
+ public:
+  static constexpr size_t kDefaultCapacity = 4096;
+  // Smallest free space handed to a read
+  static constexpr size_t kMinRead = 1024;
+
+  explicit RecvBuffer(size_t capacity = kDefaultCapacity) {
+    reallocate(std::max(capacity, kMinRead));
+  }
+
+  /*
+   * @brief Free space at the end for the next read, at least kMinRead
+   */
+  std::span<uint8_t> prepare() {
+    const size_t pending = end_ - begin_;
+    if (pending == 0 && exclusive()) {
+      begin_ = end_ = 0;
+    }
+    if (capacity_ - end_ < kMinRead) {
+      if (capacity_ - pending < kMinRead) {
+        reallocate(std::max(capacity_ * 2, pending + kMinRead));
+      } else if (!exclusive()) {
+        reallocate(capacity_);
+      } else {
+        std::memmove(data_, data_ + begin_, pending);
+        begin_ = 0;
+        end_ = pending;
+      }
+    }
+    return {data_ + end_, capacity_ - end_};
+  }
+
+  void commit(size_t n) noexcept {
+    end_ += n;
+  }
+
+  /*
+   * @brief Bytes read and not consumed yet
+   */
+  std::span<const uint8_t> data() const noexcept {
+    return {data_ + begin_, end_ - begin_};
+  }
+
+  void consume(size_t n) noexcept {
+    begin_ += n;
+  }
+
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  const std::shared_ptr<const void> &owner() const noexcept {
+    return owner_;
+  }
+
+ private:
+  // No retained message points into the storage
+  bool exclusive() const noexcept {
+    if (owner_.use_count() != 1) return false;
+    // Pairs with the release of the last retainer, its reads of the bytes
+    // happen before the buffer is written again
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return true;
+  }
+
+  void reallocate(size_t capacity) {
+    auto storage = std::make_shared_for_overwrite<uint8_t[]>(capacity);
+    const size_t pending = end_ - begin_;
+    if (pending > 0) std::memcpy(storage.get(), data_ + begin_, pending);
+    data_ = storage.get();
+    capacity_ = capacity;
+    begin_ = 0;
+    end_ = pending;
+    owner_ = std::move(storage);
+  }
+
+  std::shared_ptr<const void> owner_;
+  uint8_t *data_ = nullptr;
+  size_t capacity_ = 0;
+  size_t begin_ = 0;
+  size_t end_ = 0;
+};
+
+/*
+ * @brief Call fn(const MessageView &) for every complete message in recv
+ *        and consume it. Codecs with decodeView() frame in place, others go
+ *        through append()/tryDecode() and each frame is viewed in its own
+ *        vector. Without a codec every read is one message.
+ */
+template <typename Fn>
+void decodeViews(IFrameCodec *codec, RecvBuffer &recv, Fn &&fn) {
+  if (!codec) {
+    const auto data = recv.data();
+    recv.consume(data.size());
+    fn(MessageView(data, recv.owner()));
+    return;
+  }
+
+  if (codec->supportsView()) {
+    auto sink = [&](std::span<const uint8_t> payload) {
+      fn(MessageView(payload, recv.owner()));
+    };
+    recv.consume(codec->decodeBatch(recv.data(), sink));
+    return;
+  }
+
+  const auto data = recv.data();
+  codec->append(data.data(), data.size());
+  recv.consume(data.size());
+  while (auto frame = codec->tryDecode()) {
+    auto bytes = std::make_shared<const std::vector<uint8_t>>(
+        std::move(*frame));
+    const std::shared_ptr<const void> owner = bytes;
+    fn(MessageView(*bytes, owner));
+  }
+}
+
+} // namespace net
+} // namespace sdk
@@ -11,6 +11,8 @@
 #pragma once
 
 #include "network/frame_codec_base.h"
+#include "network/message_view.h"
+#include "network/write_coalescing.h"
 
 #include <functional>
 #include <memory>
@@ -28,6 +30,8 @@ class TcpClient {
   using MessageHandler =
       std::function<void(const std::vector<uint8_t> &payload)>;
   using ConnectHandler = std::function<void(int conn_id)>;
+  // Zero-copy alternative to MessageHandler, see MessageView
+  using MessageViewHandler = std::function<void(const MessageView &msg)>;
   using DisconnectHandler =
       std::function<void(int conn_id, int code, const std::string &message)>;
 
@@ -58,8 +62,24 @@ class TcpClient {
 
   virtual void setCodecFactory(CodecFactory factory) = 0;
 
+  /*
+   * @brief Limits for gathering queued frames into one vectored write,
+   *        call before start()
+   */
+  virtual void setWriteCoalescing(WriteCoalescing limits) = 0;
+
+  /*
+   * @brief Write counters, frames per write shows the batching
+   */
+  virtual WriteStats writeStats() const = 0;
+
   virtual void onError(ErrorHandler cb) = 0;
   virtual void onMessage(MessageHandler cb) = 0;
+  /*
+   * @brief Receive messages as views into the receive buffer instead of
+   *        vector copies, replaces onMessage() when set
+   */
+  virtual void onMessageView(MessageViewHandler cb) = 0;
   virtual void onConnect(ConnectHandler cb) = 0;
   virtual void onDisconnect(DisconnectHandler cb) = 0;
 };
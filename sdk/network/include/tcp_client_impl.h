@@ -12,7 +12,9 @@
 
 #include "macro/macros.h"
 #include "network/frame_codec_base.h"
+#include "network/recv_buffer.h"
 #include "network/tcp_client.h"
+#include "network/write_coalescing.h"
 
 #include <cstdint>
 
@@ -57,6 +59,7 @@ class TcpClientImpl : public TcpClient {
   // Callback
   void onError(ErrorHandler cb) override;
   void onMessage(MessageHandler cb) override;
+  void onMessageView(MessageViewHandler cb) override;
   void onConnect(ConnectHandler cb) override;
   void onDisconnect(DisconnectHandler cb) override;
 
@@ -65,6 +68,16 @@ class TcpClientImpl : public TcpClient {
     codec_factory_ = std::move(factory);
   }
 
+  void setWriteCoalescing(WriteCoalescing limits) override {
+    writeLimits_ = limits;
+  }
+
+  WriteStats writeStats() const override {
+    WriteStats stats;
+    writeCounters_.addTo(stats);
+    return stats;
+  }
+
  private:
   struct Session : public std::enable_shared_from_this<Session> {
     Session(int id, boost::asio::ip::tcp::socket socket, TcpClientImpl *client);
@@ -83,10 +96,12 @@ class TcpClientImpl : public TcpClient {
     boost::asio::strand<boost::asio::io_context::executor_type> strand;
     boost::asio::ip::tcp::socket socket;
 
-    std::array<uint8_t, 4096> readBuf;
+    RecvBuffer recv;
 
     using Buffer = std::vector<uint8_t>;
     std::deque<Buffer> writeQueue;
+    // Front of writeQueue in flight, popped when the write completes
+    std::vector<boost::asio::const_buffer> writeBufs;
 
     std::unique_ptr<IFrameCodec> codec;
 
@@ -121,6 +136,7 @@ class TcpClientImpl : public TcpClient {
   // Callback
   ErrorHandler onError_;
   MessageHandler onMessage_;
+  MessageViewHandler onMessageView_;
   ConnectHandler onConnect_;
   DisconnectHandler onDisconnect_;
   // Codec
@@ -129,6 +145,8 @@ class TcpClientImpl : public TcpClient {
   std::shared_ptr<Session> session_;
   // Flow control
   size_t maxWriteQueueSize_ = 1024;
+  WriteCoalescing writeLimits_;
+  WriteCounters writeCounters_;
 
   DISALLOW_COPY(TcpClientImpl);
 };
@@ -11,6 +11,8 @@
 #pragma once
 
 #include "network/frame_codec_base.h"
+#include "network/message_view.h"
+#include "network/write_coalescing.h"
 
 #include <cstdint>
 
@@ -32,11 +34,20 @@ class TcpServer {
   using DisconnectHandler =
       std::function<void(int conn_id, int code, const std::string &message)>;
   using ConnectHandler = std::function<void(int conn_id)>;
+  // Zero-copy alternative to MessageHandler, see MessageView
+  using MessageViewHandler =
+      std::function<void(int conn_id, const MessageView &msg)>;
 
   TcpServer() = default;
   virtual ~TcpServer() = default;
 
-  static std::unique_ptr<TcpServer> Create(uint16_t port);
+  /*
+   * @brief Server on port with threads reactors (0 for one per hardware
+   *        thread). With more than one, handlers are called concurrently
+   *        from several threads, though always from the same one for a
+   *        given conn_id.
+   */
+  static std::unique_ptr<TcpServer> Create(uint16_t port, size_t threads = 1);
 
   virtual void start() = 0;
   virtual void stop() = 0;
@@ -44,9 +55,25 @@ class TcpServer {
 
   virtual void setCodecFactory(CodecFactory factory) = 0;
 
+  /*
+   * @brief Limits for gathering queued frames into one vectored write,
+   *        call before start()
+   */
+  virtual void setWriteCoalescing(WriteCoalescing limits) = 0;
+
+  /*
+   * @brief Write counters, frames per write shows the batching
+   */
+  virtual WriteStats writeStats() const = 0;
+
   virtual void onDisconnect(DisconnectHandler cb) = 0;
   virtual void onError(ErrorHandler cb) = 0;
   virtual void onMessage(MessageHandler cb) = 0;
+  /*
+   * @brief Receive messages as views into the receive buffer instead of
+   *        vector copies, replaces onMessage() when set
+   */
+  virtual void onMessageView(MessageViewHandler cb) = 0;
   virtual void onConnect(ConnectHandler cb) = 0;
 };
 
@@ -12,7 +12,9 @@
 
 #include "macro/macros.h"
 #include "network/frame_codec_base.h"
+#include "network/recv_buffer.h"
 #include "network/tcp_server.h"
+#include "network/write_coalescing.h"
 
 #include <atomic>
 #include <boost/asio.hpp>
@@ -20,13 +22,29 @@
 #include <memory>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace sdk {
 namespace net {
 
+// Multi-reactor server: one io_context per thread, each run by its own
+// thread, and every connection pinned to one of them for its whole life
+//
+// With SO_REUSEPORT each reactor owns a listening socket on the port and the
+// kernel spreads incoming connections over them. Without it, or with a
+// single reactor, reactor 0 accepts and hands the sockets out round robin.
+// A conn_id encodes its reactor (conn_id % reactor count), so send() posts
+// straight to the owner and sessions are only ever touched by one thread.
+//
+// With more than one reactor the handlers run concurrently from several
+// threads, but the calls for one connection always come from the same one.
 class TcpServerImpl : public TcpServer {
  public:
-  explicit TcpServerImpl(uint16_t port);
+  /*
+   * @brief Bind to port on all reactors
+   * @param threads number of reactors, 0 for one per hardware thread
+   */
+  explicit TcpServerImpl(uint16_t port, size_t threads = 1);
   ~TcpServerImpl() override;
 
   void start() override;
@@ -40,6 +58,9 @@ class TcpServerImpl : public TcpServer {
   void onMessage(MessageHandler cb) override {
     onMessage_ = std::move(cb);
   }
+  void onMessageView(MessageViewHandler cb) override {
+    onMessageView_ = std::move(cb);
+  }
   void onDisconnect(DisconnectHandler cb) override {
     onDisconnect_ = std::move(cb);
   }
@@ -52,13 +73,26 @@ class TcpServerImpl : public TcpServer {
     codec_factory_ = std::move(factory);
   }
 
-  boost::asio::io_context &get_io_context() {
-    return io_;
+  void setWriteCoalescing(WriteCoalescing limits) override {
+    writeLimits_ = limits;
+  }
+
+  WriteStats writeStats() const override;
+
+  boost::asio::io_context &get_io_context(size_t reactor = 0) {
+    return reactors_[reactor]->io;
+  }
+
+  size_t reactor_count() const noexcept {
+    return reactors_.size();
   }
 
  private:
+  struct Reactor;
+
   struct Session : public std::enable_shared_from_this<Session> {
-    Session(int id, boost::asio::ip::tcp::socket socket, TcpServerImpl *server);
+    Session(int id, boost::asio::ip::tcp::socket socket, TcpServerImpl *server,
+            Reactor *reactor);
 
     void start();
     void doRead();
@@ -68,39 +102,65 @@ class TcpServerImpl : public TcpServer {
 
     int id;
     TcpServerImpl *server;
+    Reactor *reactor;
 
     boost::asio::ip::tcp::socket socket;
     boost::asio::strand<boost::asio::io_context::executor_type> strand;
 
-    std::array<uint8_t, 4096> readBuf;
+    RecvBuffer recv;
     std::deque<std::vector<uint8_t>> writeQueue;
+    // Front of writeQueue in flight, popped when the write completes
+    std::vector<boost::asio::const_buffer> writeBufs;
 
     std::unique_ptr<IFrameCodec> codec;
     DISALLOW_COPY_AND_MOVE(Session);
   };
 
-  void doAccept();
+  // One event loop and the sessions pinned to it. Everything but io is
+  // only touched from the reactor's own thread.
+  struct Reactor {
+    explicit Reactor(size_t index);
+
+    size_t index;
+    boost::asio::io_context io;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
+        work_guard;
+    // null when reactor 0 accepts for everyone
+    std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor;
+    std::unordered_map<int, std::shared_ptr<Session>> sessions;
+    WriteCounters writeCounters;
+    // Sequence of the next conn_id, only used by the accepting thread
+    int nextSeq = 1;
+    // Declared last so the thread is joined before io is destroyed
+    std::jthread worker;
+
+    DISALLOW_COPY_AND_MOVE(Reactor);
+  };
+
+  void listen(Reactor &reactor);
+  void doAccept(Reactor &reactor);
+  void addSession(Reactor &reactor, int id,
+                  boost::asio::ip::tcp::socket socket);
   void removeSession(int id);
+  Reactor &owner(int conn_id);
 
  private:
   uint16_t port_;
-  boost::asio::io_context io_;
-  boost::asio::ip::tcp::acceptor acceptor_;
-  boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
-      work_guard_;
-  std::jthread worker_;
+  bool reuse_port_ = false;
+  std::vector<std::unique_ptr<Reactor>> reactors_;
+  // Round robin cursor when reactor 0 hands out sockets
+  size_t nextReactor_ = 0;
 
   std::atomic<bool> running_{false};
-  std::atomic<int> nextConnId_{1};
-
-  std::unordered_map<int, std::shared_ptr<Session>> sessions_;
 
   ErrorHandler onError_;
   MessageHandler onMessage_;
+  MessageViewHandler onMessageView_;
   DisconnectHandler onDisconnect_;
   ConnectHandler onConnect_;
 
   CodecFactory codec_factory_;
+  WriteCoalescing writeLimits_;
 
   DISALLOW_COPY(TcpServerImpl);
 };
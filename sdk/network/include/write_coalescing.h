@@ -0,0 +1,107 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file write_coalescing.h
+ * @brief Gathering queued frames into one vectored write, and its counters.
+ * @author wizyang
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+
+namespace sdk {
+namespace net {
+
+// Limits for one write. A session gathers the frames at the front of its
+// queue until either limit is reached and hands them to a single
+// async_write, which becomes one writev() per maxBuffers buffers. A frame
+// larger than maxBytes is still written, alone.
+//
+// asio passes at most 64 iovecs to one writev(), more buffers are split
+// into several calls.
+struct WriteCoalescing {
+  size_t maxBytes = 256 * 1024;
+  size_t maxBuffers = 64;
+};
+
+// Counters of a server or client since it was created
+struct WriteStats {
+  static constexpr size_t kBuckets = 8;
+
+  uint64_t writes = 0; // async_write calls
+  uint64_t frames = 0; // queued buffers written
+  uint64_t bytes = 0;
+  // framesPerWrite[b] counts the writes of [2^b, 2^(b + 1)) frames, the
+  // last bucket also the larger ones
+  std::array<uint64_t, kBuckets> framesPerWrite{};
+
+  double averageFramesPerWrite() const noexcept {
+    return writes == 0 ? 0.0 : static_cast<double>(frames) / writes;
+  }
+};
+
+// Atomic WriteStats, updated from an io thread and read from anywhere
+class WriteCounters {
+ public:
+  void record(size_t frames, size_t bytes) noexcept {
+    writes_.fetch_add(1, std::memory_order_relaxed);
+    frames_.fetch_add(frames, std::memory_order_relaxed);
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    const size_t bucket = std::min<size_t>(
+        std::bit_width(std::max<size_t>(frames, 1)) - 1,
+        WriteStats::kBuckets - 1);
+    framesPerWrite_[bucket].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /*
+   * @brief Add these counters to stats
+   */
+  void addTo(WriteStats &stats) const noexcept {
+    stats.writes += writes_.load(std::memory_order_relaxed);
+    stats.frames += frames_.load(std::memory_order_relaxed);
+    stats.bytes += bytes_.load(std::memory_order_relaxed);
+    for (size_t b = 0; b < WriteStats::kBuckets; ++b) {
+      stats.framesPerWrite[b] +=
+          framesPerWrite_[b].load(std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  std::atomic<uint64_t> writes_{0};
+  std::atomic<uint64_t> frames_{0};
+  std::atomic<uint64_t> bytes_{0};
+  std::array<std::atomic<uint64_t>, WriteStats::kBuckets> framesPerWrite_{};
+};
+
+/*
+ * @brief Fill buffers with the frames at the front of queue, within limits
+ *        and at least one if queue is not empty
+ * @return size_t, bytes gathered
+ */
+template <typename Queue, typename Buffers>
+size_t gatherWrites(const Queue &queue, const WriteCoalescing &limits,
+                    Buffers &buffers) {
+  buffers.clear();
+  size_t bytes = 0;
+  for (const auto &frame : queue) {
+    if (!buffers.empty() && (buffers.size() >= limits.maxBuffers ||
+                             bytes + frame.size() > limits.maxBytes)) {
+      break;
+    }
+    buffers.emplace_back(frame.data(), frame.size());
+    bytes += frame.size();
+  }
+  return bytes;
+}
+
+} // namespace net
+} // namespace sdk
@@ -20,9 +20,10 @@ void TcpClientImpl::Session::start() {
 
 void TcpClientImpl::Session::doRead() {
   auto self = shared_from_this();
+  const auto buf = recv.prepare();
 
   socket.async_read_some(
-      boost::asio::buffer(readBuf),
+      boost::asio::buffer(buf.data(), buf.size()),
       boost::asio::bind_executor(strand, [this, self](auto ec, std::size_t n) {
         if (ec) {
           if (client->onDisconnect_)
@@ -32,8 +33,19 @@ void TcpClientImpl::Session::doRead() {
 
         auto impl = client;
 
+        recv.commit(n);
+        if (impl->onMessageView_) {
+          decodeViews(codec.get(), recv, [impl](const MessageView &msg) {
+            impl->onMessageView_(msg);
+          });
+          doRead();
+          return;
+        }
+
+        const auto data = recv.data();
+        recv.consume(data.size());
         if (codec) {
-          codec->append(readBuf.data(), n);
+          codec->append(data.data(), data.size());
           while (true) {
             auto frame = codec->tryDecode();
             if (!frame) break;
@@ -44,7 +56,7 @@ void TcpClientImpl::Session::doRead() {
           }
         } else {
           if (impl->onMessage_) {
-            std::vector<uint8_t> raw(readBuf.begin(), readBuf.begin() + n);
+            std::vector<uint8_t> raw(data.begin(), data.end());
             impl->onMessage_(std::move(raw));
           }
         }
@@ -74,10 +86,12 @@ void TcpClientImpl::Session::doWrite() {
   if (writeQueue.empty()) return;
 
   auto self = shared_from_this();
-  auto &buf = writeQueue.front();
+  const size_t bytes =
+      gatherWrites(writeQueue, client->writeLimits_, writeBufs);
+  client->writeCounters_.record(writeBufs.size(), bytes);
 
   boost::asio::async_write(
-      socket, boost::asio::buffer(buf),
+      socket, std::span<const boost::asio::const_buffer>(writeBufs),
       boost::asio::bind_executor(
           strand, [this, self](auto ec, std::size_t /*bytes*/) {
             if (ec) {
@@ -86,7 +100,8 @@ void TcpClientImpl::Session::doWrite() {
               return;
             }
 
-            writeQueue.pop_front();
+            writeQueue.erase(writeQueue.begin(),
+                             writeQueue.begin() + writeBufs.size());
 
             if (!writeQueue.empty()) {
               doWrite();
@@ -106,8 +121,10 @@ TcpClientImpl::~TcpClientImpl() {
 
 void TcpClientImpl::start() {
   if (running_.exchange(true)) return;
-  worker_ = std::jthread([this] { io_.run(); });
+  // Queue the connect first, io_ has no work guard and run() would return
+  // at once if the thread got there before it
   doConnect();
+  worker_ = std::jthread([this] { io_.run(); });
 }
 
 void TcpClientImpl::stop() {
@@ -200,6 +217,9 @@ void TcpClientImpl::onError(ErrorHandler cb) {
 void TcpClientImpl::onMessage(MessageHandler cb) {
   onMessage_ = std::move(cb);
 }
+void TcpClientImpl::onMessageView(MessageViewHandler cb) {
+  onMessageView_ = std::move(cb);
+}
 void TcpClientImpl::onConnect(ConnectHandler cb) {
   onConnect_ = std::move(cb);
 }
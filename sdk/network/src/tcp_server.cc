@@ -5,8 +5,8 @@
 namespace sdk {
 namespace net {
 
-std::unique_ptr<TcpServer> TcpServer::Create(uint16_t port) {
-  return std::make_unique<TcpServerImpl>(port);
+std::unique_ptr<TcpServer> TcpServer::Create(uint16_t port, size_t threads) {
+  return std::make_unique<TcpServerImpl>(port, threads);
 }
 
 } // namespace net
@@ -12,6 +12,7 @@
 
 #include "log/log.h"
 
+#include <algorithm>
 #include <memory>
 #include <stop_token>
 #include <thread>
@@ -21,85 +22,153 @@ namespace net {
 
 using boost::asio::ip::tcp;
 
-constexpr int kDefaultThreadNum = 1;
-
-TcpServerImpl::TcpServerImpl(uint16_t port)
-    : port_(port), io_(kDefaultThreadNum),
-      acceptor_(io_, tcp::endpoint(tcp::v4(), port_)),
-      work_guard_(boost::asio::make_work_guard(io_)) {
-  acceptor_.set_option(boost::asio::socket_base::reuse_address(true));
+#ifdef SO_REUSEPORT
+using reuse_port = boost::asio::detail::socket_option::boolean<SOL_SOCKET,
+                                                               SO_REUSEPORT>;
+#endif
+
+TcpServerImpl::Reactor::Reactor(size_t index)
+    : index(index), io(1), work_guard(boost::asio::make_work_guard(io)) {}
+
+TcpServerImpl::TcpServerImpl(uint16_t port, size_t threads) : port_(port) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (size_t i = 0; i < threads; ++i) {
+    reactors_.push_back(std::make_unique<Reactor>(i));
+  }
+#ifdef SO_REUSEPORT
+  reuse_port_ = reactors_.size() > 1;
+#endif
+  if (reuse_port_) {
+    for (auto &reactor : reactors_) listen(*reactor);
+  } else {
+    listen(*reactors_[0]);
+  }
 }
 
 TcpServerImpl::~TcpServerImpl() {
   stop();
+  // Handlers on one reactor may still reach another one through send()
+  for (auto &reactor : reactors_) {
+    if (reactor->worker.joinable()) reactor->worker.join();
+  }
+}
+
+void TcpServerImpl::listen(Reactor &reactor) {
+  auto acceptor = std::make_unique<tcp::acceptor>(reactor.io);
+  acceptor->open(tcp::v4());
+  acceptor->set_option(boost::asio::socket_base::reuse_address(true));
+#ifdef SO_REUSEPORT
+  if (reuse_port_) acceptor->set_option(reuse_port(true));
+#endif
+  acceptor->bind(tcp::endpoint(tcp::v4(), port_));
+  acceptor->listen();
+  // Port 0 picks an ephemeral port, the other reactors must share it
+  port_ = acceptor->local_endpoint().port();
+  reactor.acceptor = std::move(acceptor);
 }
 
 void TcpServerImpl::start() {
   // LOG(INFO) << "[SERVER] start()\n";
   if (running_.exchange(true)) return;
-  worker_ = std::jthread([this](std::stop_token st) { io_.run(); });
-  // LOG(INFO) << "[SERVER] calling doAccept()\n";
-  doAccept();
+  for (auto &reactor : reactors_) {
+    Reactor *r = reactor.get();
+    r->worker = std::jthread([r](std::stop_token st) { r->io.run(); });
+    // LOG(INFO) << "[SERVER] calling doAccept()\n";
+    if (r->acceptor) {
+      boost::asio::post(r->io, [this, r] { doAccept(*r); });
+    }
+  }
 }
 
 void TcpServerImpl::stop() {
   if (!running_.exchange(false)) return;
-  boost::asio::post(io_, [this] {
-    boost::system::error_code ec;
-    acceptor_.cancel(ec); // NOLINT
-    acceptor_.close(ec);  // NOLINT
-    for (auto &kv : sessions_) {
-      kv.second->close();
-    }
-    sessions_.clear();
-    work_guard_.reset();
-    io_.stop();
-  });
+  for (auto &reactor : reactors_) {
+    Reactor *r = reactor.get();
+    boost::asio::post(r->io, [r] {
+      boost::system::error_code ec;
+      if (r->acceptor) {
+        r->acceptor->cancel(ec); // NOLINT
+        r->acceptor->close(ec);  // NOLINT
+      }
+      for (auto &kv : r->sessions) {
+        kv.second->close();
+      }
+      r->sessions.clear();
+      r->work_guard.reset();
+      r->io.stop();
+    });
+  }
 }
 
 void TcpServerImpl::send(int conn_id, std::span<const uint8_t> data) {
-  if (!running_) return;
+  if (!running_ || conn_id <= 0) return;
+  Reactor &r = owner(conn_id);
   std::vector<uint8_t> buff(data.begin(), data.end());
-  boost::asio::post(io_, [this, conn_id, buff = std::move(buff)]() mutable {
-    auto it = sessions_.find(conn_id);
-    if (it == sessions_.end()) return;
+  boost::asio::post(r.io, [&r, conn_id, buff = std::move(buff)]() mutable {
+    auto it = r.sessions.find(conn_id);
+    if (it == r.sessions.end()) return;
     it->second->enqueueWrite(std::move(buff));
   });
 }
 
+TcpServerImpl::Reactor &TcpServerImpl::owner(int conn_id) {
+  return *reactors_[static_cast<size_t>(conn_id) % reactors_.size()];
+}
+
 void TcpServerImpl::removeSession(int id) {
-  sessions_.erase(id);
-}
-
-void TcpServerImpl::doAccept() {
-  acceptor_.async_accept([this](auto ec, tcp::socket socket) {
-    // LOG(INFO) << "[SERVER] accept handler called, ec=" << ec.message() <<
-    // "\n";
-    if (!running_) return;
-    if (ec) {
-      if (onError_) onError_(-1, ec.value(), ec.message());
-      doAccept();
-      return;
-    }
-    LOG(INFO) << "[SERVER] client accepted\n";
-    int id = nextConnId_++;
-    auto session = std::make_shared<Session>(id, std::move(socket), this);
-    if (codec_factory_)
-      session->codec = codec_factory_();
-    else
-      session->codec.reset();
-
-    sessions_[id] = session;
-    session->start();
-    if (onConnect_) onConnect_(id);
-    doAccept();
-  });
+  owner(id).sessions.erase(id);
+}
+
+void TcpServerImpl::doAccept(Reactor &reactor) {
+  // The socket is created on the reactor that will own the connection, so
+  // with a single acceptor the handoff is just a post to that reactor
+  Reactor *target = &reactor;
+  if (!reuse_port_) {
+    target = reactors_[nextReactor_].get();
+    nextReactor_ = (nextReactor_ + 1) % reactors_.size();
+  }
+  reactor.acceptor->async_accept(
+      target->io, [this, &reactor, target](auto ec, tcp::socket socket) {
+        // LOG(INFO) << "[SERVER] accept handler called, ec=" << ec.message()
+        // << "\n";
+        if (!running_) return;
+        if (ec) {
+          if (onError_) onError_(-1, ec.value(), ec.message());
+          doAccept(reactor);
+          return;
+        }
+        LOG(INFO) << "[SERVER] client accepted\n";
+        // conn_id % reactor count is the owner's index
+        int id = static_cast<int>(target->nextSeq++ * reactors_.size() +
+                                  target->index);
+        boost::asio::dispatch(
+            target->io, [this, target, id, s = std::move(socket)]() mutable {
+              addSession(*target, id, std::move(s));
+            });
+        doAccept(reactor);
+      });
+}
+
+void TcpServerImpl::addSession(Reactor &reactor, int id, tcp::socket socket) {
+  if (!running_) return;
+  auto session =
+      std::make_shared<Session>(id, std::move(socket), this, &reactor);
+  if (codec_factory_)
+    session->codec = codec_factory_();
+  else
+    session->codec.reset();
+
+  reactor.sessions[id] = session;
+  session->start();
+  if (onConnect_) onConnect_(id);
 }
 
 TcpServerImpl::Session::Session(int id, tcp::socket socket,
-                                TcpServerImpl *server)
-    : id(id), server(server), socket(std::move(socket)),
-      strand(server->io_.get_executor()) {}
+                                TcpServerImpl *server, Reactor *reactor)
+    : id(id), server(server), reactor(reactor), socket(std::move(socket)),
+      strand(reactor->io.get_executor()) {}
 
 void TcpServerImpl::Session::start() {
   doRead();
@@ -113,9 +182,10 @@ void TcpServerImpl::Session::close() {
 
 void TcpServerImpl::Session::doRead() {
   auto self = shared_from_this();
+  const auto buf = recv.prepare();
 
   socket.async_read_some(
-      boost::asio::buffer(readBuf),
+      boost::asio::buffer(buf.data(), buf.size()),
       boost::asio::bind_executor(strand, [this, self](auto ec, std::size_t n) {
         // LOG(INFO) << "[SERVER] read handler: ec=" << ec.message()
         //           << ", bytes=" << n << "\n";
@@ -127,8 +197,19 @@ void TcpServerImpl::Session::doRead() {
           return;
         }
 
+        recv.commit(n);
+        if (server->onMessageView_) {
+          decodeViews(codec.get(), recv, [this](const MessageView &msg) {
+            server->onMessageView_(id, msg);
+          });
+          doRead();
+          return;
+        }
+
+        const auto data = recv.data();
+        recv.consume(data.size());
         if (codec) {
-          codec->append(readBuf.data(), n);
+          codec->append(data.data(), data.size());
 
           while (true) {
             auto frame = codec->tryDecode();
@@ -140,8 +221,8 @@ void TcpServerImpl::Session::doRead() {
           }
         } else {
           if (server->onMessage_) {
-            server->onMessage_(
-                id, std::vector<uint8_t>(readBuf.begin(), readBuf.begin() + n));
+            server->onMessage_(id,
+                               std::vector<uint8_t>(data.begin(), data.end()));
           }
         }
 
@@ -159,14 +240,22 @@ void TcpServerImpl::Session::enqueueWrite(std::vector<uint8_t> data) {
   });
 }
 
+WriteStats TcpServerImpl::writeStats() const {
+  WriteStats stats;
+  for (const auto &reactor : reactors_) reactor->writeCounters.addTo(stats);
+  return stats;
+}
+
 void TcpServerImpl::Session::doWrite() {
   if (writeQueue.empty()) return;
 
   auto self = shared_from_this();
-  auto &buf = writeQueue.front();
+  const size_t bytes =
+      gatherWrites(writeQueue, server->writeLimits_, writeBufs);
+  reactor->writeCounters.record(writeBufs.size(), bytes);
 
   boost::asio::async_write(
-      socket, boost::asio::buffer(buf),
+      socket, std::span<const boost::asio::const_buffer>(writeBufs),
       boost::asio::bind_executor(
           strand, [this, self](auto ec, std::size_t /*bytes*/) {
             if (ec) {
@@ -176,7 +265,8 @@ void TcpServerImpl::Session::doWrite() {
               return;
             }
 
-            writeQueue.pop_front();
+            writeQueue.erase(writeQueue.begin(),
+                             writeQueue.begin() + writeBufs.size());
             if (!writeQueue.empty()) doWrite();
           }));
 }
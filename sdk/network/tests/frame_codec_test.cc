@@ -0,0 +1,259 @@
+// Copyright 2025 The cppsdk Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file frame_codec_test.cc
+ * @brief Tests for the frame codecs.
+ * @author wizyang
+ */
+
+#include "network/byte_search.h"
+#include "network/frame_codec_adapter.h"
+#include "network/frame_codec_delimiter.h"
+#include "network/frame_codec_length.h"
+#include "network/frame_codec_simple.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace sdk::net;
+
+namespace {
+
+std::vector<uint8_t> magicFrame(const std::string &s) {
+  return SimpleMagicCodec().encode(reinterpret_cast<const uint8_t *>(s.data()),
+                                   s.size());
+}
+
+std::string str(const std::vector<uint8_t> &v) {
+  return std::string(v.begin(), v.end());
+}
+
+std::string str(std::span<const uint8_t> v) {
+  return std::string(v.begin(), v.end());
+}
+
+std::span<const uint8_t> bytes(const std::string &s) {
+  return {reinterpret_cast<const uint8_t *>(s.data()), s.size()};
+}
+
+// Encode payloads with codec, then decode the stream fed in chunks through
+// both the buffered and the view path of FrameCodecAdapter
+template <typename Codec>
+void expectRoundTrip(const Codec &codec,
+                     const std::vector<std::string> &payloads) {
+  std::vector<uint8_t> stream;
+  for (const auto &p : payloads) codec.encode(bytes(p), stream);
+
+  for (size_t chunk : {1, 3, 7, 64, 100000}) {
+    FrameCodecAdapter<Codec> buffered(codec);
+    std::vector<std::string> got;
+    for (size_t off = 0; off < stream.size(); off += chunk) {
+      buffered.append(stream.data() + off,
+                      std::min(chunk, stream.size() - off));
+      while (auto frame = buffered.tryDecode()) got.push_back(str(*frame));
+    }
+    EXPECT_EQ(got, payloads) << "chunk " << chunk;
+
+    FrameCodecAdapter<Codec> viewed(codec);
+    got.clear();
+    size_t consumed = 0;
+    for (size_t end = 0; end < stream.size();) {
+      end = std::min(end + chunk, stream.size());
+      auto sink = [&](std::span<const uint8_t> p) { got.push_back(str(p)); };
+      IFrameCodec &base = viewed;
+      consumed += base.decodeBatch(
+          std::span<const uint8_t>(stream).subspan(consumed, end - consumed),
+          sink);
+    }
+    EXPECT_EQ(got, payloads) << "chunk " << chunk;
+    EXPECT_EQ(consumed, stream.size());
+  }
+}
+
+const std::vector<std::string> kPayloads = {
+    "", "a", "hello", std::string(300, 'x'), std::string(70000, 'y'), "end"};
+
+} // namespace
+
+TEST(ByteSearchTest, FindBytePairMatchesScalar) {
+  std::mt19937 rng(7);
+  // Few distinct values so that pairs and near misses are frequent
+  std::uniform_int_distribution<int> dist(0, 3);
+  for (size_t n : {0, 1, 2, 15, 16, 17, 18, 33, 100, 1000}) {
+    for (int round = 0; round < 50; ++round) {
+      std::vector<uint8_t> v(n);
+      for (auto &x : v) x = uint8_t(0xAA + dist(rng));
+      size_t expected = n;
+      for (size_t i = 0; i + 1 < n; ++i) {
+        if (v[i] == 0xAB && v[i + 1] == 0xAC) {
+          expected = i;
+          break;
+        }
+      }
+      EXPECT_EQ(findBytePair(v.data(), n, 0xAB, 0xAC), expected) << n;
+    }
+  }
+}
+
+TEST(ByteSearchTest, TrailingFirstByteIsNotAMatch) {
+  std::vector<uint8_t> v(40, 0);
+  v.back() = 0xAB;
+  EXPECT_EQ(findBytePair(v.data(), v.size(), 0xAB, 0xCD), v.size());
+  v.push_back(0xCD);
+  EXPECT_EQ(findBytePair(v.data(), v.size(), 0xAB, 0xCD), 39u);
+}
+
+TEST(SimpleMagicCodecTest, DecodesAcrossChunks) {
+  std::vector<uint8_t> stream;
+  for (int i = 0; i < 200; ++i) {
+    // garbage, including magic halves, between some frames
+    if (i % 7 == 0) stream.insert(stream.end(), {0xAB, 0x00, 0xCD, 0xAB});
+    auto f = magicFrame("frame-" + std::to_string(i));
+    stream.insert(stream.end(), f.begin(), f.end());
+  }
+
+  for (size_t chunk : {1, 2, 5, 6, 7, 64, 4096}) {
+    SimpleMagicCodec codec;
+    int next = 0;
+    for (size_t off = 0; off < stream.size(); off += chunk) {
+      codec.append(stream.data() + off, std::min(chunk, stream.size() - off));
+      while (auto frame = codec.tryDecode()) {
+        EXPECT_EQ(str(*frame), "frame-" + std::to_string(next)) << chunk;
+        ++next;
+      }
+    }
+    EXPECT_EQ(next, 200) << "chunk " << chunk;
+  }
+}
+
+TEST(SimpleMagicCodecTest, ResyncSkipsLargeGarbage) {
+  SimpleMagicCodec codec;
+  std::vector<uint8_t> garbage(1 << 20, 0xAB);
+  codec.append(garbage.data(), garbage.size());
+  EXPECT_FALSE(codec.tryDecode());
+
+  // The trailing 0xAB is kept as a possible magic start: 0xCD completes it
+  const uint8_t rest[] = {0xCD, 0, 0, 0, 2, 'h', 'i'};
+  codec.append(rest, sizeof(rest));
+  auto frame = codec.tryDecode();
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(str(*frame), "hi");
+  EXPECT_FALSE(codec.tryDecode());
+}
+
+TEST(SimpleMagicCodecTest, EmptyPayload) {
+  SimpleMagicCodec codec;
+  auto f = magicFrame("");
+  codec.append(f.data(), f.size());
+  auto frame = codec.tryDecode();
+  ASSERT_TRUE(frame);
+  EXPECT_TRUE(frame->empty());
+}
+
+static_assert(FrameCodec<MagicFrameCodec>);
+static_assert(FrameCodec<LengthPrefixCodec<uint8_t>>);
+static_assert(FrameCodec<VarintLengthCodec>);
+static_assert(FrameCodec<DelimiterCodec>);
+
+TEST(LengthPrefixCodecTest, Header) {
+  std::vector<uint8_t> out;
+  LengthPrefixCodec<uint16_t, std::endian::big>().encode(bytes("abc"), out);
+  EXPECT_EQ(out, (std::vector<uint8_t>{0, 3, 'a', 'b', 'c'}));
+  out.clear();
+  LengthPrefixCodec<uint32_t, std::endian::little>().encode(bytes("ab"), out);
+  EXPECT_EQ(out, (std::vector<uint8_t>{2, 0, 0, 0, 'a', 'b'}));
+  out.clear();
+  LengthPrefixCodec<uint64_t>().encode(bytes("a"), out);
+  EXPECT_EQ(out, (std::vector<uint8_t>{0, 0, 0, 0, 0, 0, 0, 1, 'a'}));
+
+  // Too long for one byte of length
+  out.clear();
+  LengthPrefixCodec<uint8_t>().encode(bytes(std::string(256, 'x')), out);
+  EXPECT_TRUE(out.empty());
+}
+
+TEST(LengthPrefixCodecTest, RoundTrip) {
+  const std::vector<std::string> shortPayloads = {"", "a", "hello",
+                                                  std::string(255, 'x')};
+  expectRoundTrip(LengthPrefixCodec<uint8_t>(), shortPayloads);
+  expectRoundTrip(LengthPrefixCodec<uint8_t, std::endian::little>(),
+                  shortPayloads);
+  expectRoundTrip(LengthPrefixCodec<uint16_t>(), shortPayloads);
+  expectRoundTrip(LengthPrefixCodec<uint16_t, std::endian::little>(),
+                  shortPayloads);
+  expectRoundTrip(LengthPrefixCodec<uint32_t>(), kPayloads);
+  expectRoundTrip(LengthPrefixCodec<uint32_t, std::endian::little>(),
+                  kPayloads);
+  expectRoundTrip(LengthPrefixCodec<uint64_t>(), kPayloads);
+  expectRoundTrip(LengthPrefixCodec<uint64_t, std::endian::little>(),
+                  kPayloads);
+}
+
+TEST(VarintLengthCodecTest, Header) {
+  std::vector<uint8_t> out;
+  VarintLengthCodec().encode(bytes(std::string(300, 'x')), out);
+  EXPECT_EQ(out[0], 0xAC);
+  EXPECT_EQ(out[1], 0x02);
+  EXPECT_EQ(out.size(), 302u);
+}
+
+TEST(VarintLengthCodecTest, RoundTrip) {
+  expectRoundTrip(VarintLengthCodec(),
+                  {"", std::string(127, 'a'), std::string(128, 'b'),
+                   std::string(16383, 'c'), std::string(16384, 'd')});
+}
+
+TEST(VarintLengthCodecTest, OverlongVarintIsDropped) {
+  std::vector<uint8_t> stream(9, 0xFF);
+  stream.push_back(0x02); // bit 64
+  VarintLengthCodec().encode(bytes("ok"), stream);
+
+  FrameCodecAdapter<VarintLengthCodec> codec;
+  codec.append(stream.data(), stream.size());
+  auto frame = codec.tryDecode();
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(str(*frame), "ok");
+}
+
+TEST(DelimiterCodecTest, RoundTrip) {
+  const std::vector<std::string> lines = {"", "GET / HTTP/1.1", "a\rb",
+                                          std::string(5000, 'x'), "last"};
+  expectRoundTrip(DelimiterCodec(), lines);
+  expectRoundTrip(DelimiterCodec("\r\n"), lines);
+  expectRoundTrip(DelimiterCodec("\r\n\r\n"), lines);
+}
+
+TEST(DelimiterCodecTest, DelimiterSplitAcrossReads) {
+  FrameCodecAdapter<DelimiterCodec> codec(std::string("\r\n"));
+  const std::string stream = "one\r\ntwo\r\n";
+  std::vector<std::string> got;
+  for (char c : stream) {
+    codec.append(reinterpret_cast<const uint8_t *>(&c), 1);
+    auto frame = codec.tryDecode();
+    // only the '\n' completing a delimiter ends a frame
+    EXPECT_EQ(frame.has_value(), c == '\n');
+    if (frame) got.push_back(str(*frame));
+  }
+  EXPECT_EQ(got, (std::vector<std::string>{"one", "two"}));
+}
+
+TEST(FrameCodecAdapterTest, MagicRoundTrip) {
+  expectRoundTrip(MagicFrameCodec(), kPayloads);
+}
+
+TEST(FrameCodecAdapterTest, MakeCodecFactory) {
+  auto factory = makeCodecFactory<DelimiterCodec>(std::string(";"));
+  auto codec = factory();
+  const std::string s = "a;bc;";
+  codec->append(reinterpret_cast<const uint8_t *>(s.data()), s.size());
+  EXPECT_EQ(str(*codec->tryDecode()), "a");
+  EXPECT_EQ(str(*codec->tryDecode()), "bc");
+  EXPECT_FALSE(codec->tryDecode());
+
+  auto magic = makeCodecFactory<SimpleMagicCodec>()();
+  EXPECT_TRUE(magic->supportsView());
+}
@@ -9,19 +9,32 @@
  */
 
 #include "log/log.h"
+#include "network/frame_codec_adapter.h"
+#include "network/frame_codec_delimiter.h"
 #include "network/frame_codec_simple.h"
 #include "network/tcp_client.h"
 #include "network/tcp_server.h"
+#include "network/write_coalescing.h"
 #include "sdk/network/include/tcp_server.h"
 
+#include <deque>
 #include <gtest/gtest.h>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace sdk::net;
 using namespace std::chrono_literals;
 
 constexpr int kServerTestPort1 = 9001;
 constexpr int kServerTestPort2 = 9002;
+constexpr int kServerTestPort3 = 9003;
+constexpr int kServerTestPort4 = 9004;
+constexpr int kServerTestPort5 = 9005;
+constexpr int kServerTestPort6 = 9006;
 
 class TcpClientServerTest : public ::testing::Test {
  protected:
@@ -53,6 +66,253 @@ TEST_F(TcpClientServerTest, BasicSendRecv) {
   client->stop();
 }
 
+TEST_F(TcpClientServerTest, MultiReactorEcho) {
+  constexpr int kClients = 8;
+
+  auto server = TcpServer::Create(kServerTestPort3, 4);
+  server->setCodecFactory([] { return std::make_unique<SimpleMagicCodec>(); });
+
+  std::mutex mu;
+  std::set<int> connIds;
+  server->onConnect([&](int connId) {
+    std::lock_guard<std::mutex> lock(mu);
+    connIds.insert(connId);
+  });
+  // Runs on the connection's reactor, send() routes back to the same one
+  server->onMessage([&](int connId, const std::vector<uint8_t> &payload) {
+    auto frame = SimpleMagicCodec().encode(payload.data(), payload.size());
+    server->send(connId, frame);
+  });
+  server->start();
+
+  std::atomic<int> echoed = 0;
+  std::vector<std::unique_ptr<TcpClient>> clients;
+  for (int i = 0; i < kClients; ++i) {
+    auto client = TcpClient::Create("127.0.0.1", kServerTestPort3);
+    client->setCodecFactory(
+        [] { return std::make_unique<SimpleMagicCodec>(); });
+    const std::string expected = "client-" + std::to_string(i);
+    client->onMessage([&echoed, expected](const std::vector<uint8_t> &p) {
+      if (std::string(p.begin(), p.end()) == expected) echoed++;
+    });
+    client->start();
+    clients.push_back(std::move(client));
+  }
+  std::this_thread::sleep_for(400ms);
+
+  for (int i = 0; i < kClients; ++i) {
+    const std::string msg = "client-" + std::to_string(i);
+    auto frame = SimpleMagicCodec().encode(
+        reinterpret_cast<const uint8_t *>(msg.data()), msg.size());
+    clients[i]->send(std::span<const uint8_t>(frame));
+  }
+  for (int i = 0; i < 100 && echoed < kClients; ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT_EQ(echoed.load(), kClients);
+  {
+    std::lock_guard<std::mutex> lock(mu);
+    EXPECT_EQ(connIds.size(), static_cast<size_t>(kClients));
+  }
+
+  for (auto &client : clients) client->stop();
+  server->stop();
+}
+
+TEST(WriteCoalescingTest, GatherRespectsLimits) {
+  std::deque<std::vector<uint8_t>> queue;
+  for (int i = 0; i < 10; ++i) queue.emplace_back(100, uint8_t(i));
+  std::vector<std::span<const uint8_t>> buffers;
+
+  EXPECT_EQ(gatherWrites(queue, WriteCoalescing{}, buffers), 1000u);
+  EXPECT_EQ(buffers.size(), 10u);
+
+  EXPECT_EQ(gatherWrites(queue, WriteCoalescing{1 << 20, 4}, buffers), 400u);
+  EXPECT_EQ(buffers.size(), 4u);
+  EXPECT_EQ(buffers[3][0], 3);
+
+  EXPECT_EQ(gatherWrites(queue, WriteCoalescing{250, 64}, buffers), 200u);
+  EXPECT_EQ(buffers.size(), 2u);
+
+  // A frame over the byte limit still goes out, alone
+  EXPECT_EQ(gatherWrites(queue, WriteCoalescing{50, 64}, buffers), 100u);
+  EXPECT_EQ(buffers.size(), 1u);
+
+  queue.clear();
+  EXPECT_EQ(gatherWrites(queue, WriteCoalescing{}, buffers), 0u);
+  EXPECT_TRUE(buffers.empty());
+}
+
+TEST_F(TcpClientServerTest, CoalescedWritesKeepOrder) {
+  constexpr int kFrames = 1000;
+
+  auto server = TcpServer::Create(kServerTestPort4);
+  server->setCodecFactory([] { return std::make_unique<SimpleMagicCodec>(); });
+  server->setWriteCoalescing({16 * 1024, 32});
+  std::atomic<int> connId = 0;
+  server->onConnect([&](int id) { connId = id; });
+  server->start();
+
+  std::atomic<int> received = 0;
+  std::atomic<bool> ordered = true;
+  auto client = TcpClient::Create("127.0.0.1", kServerTestPort4);
+  client->setCodecFactory([] { return std::make_unique<SimpleMagicCodec>(); });
+  client->onMessage([&](const std::vector<uint8_t> &p) {
+    if (std::string(p.begin(), p.end()) != std::to_string(received.load())) {
+      ordered = false;
+    }
+    received++;
+  });
+  client->start();
+  for (int i = 0; i < 100 && connId == 0; ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  ASSERT_NE(connId.load(), 0);
+
+  size_t bytes = 0;
+  for (int i = 0; i < kFrames; ++i) {
+    const std::string msg = std::to_string(i);
+    auto frame = SimpleMagicCodec().encode(
+        reinterpret_cast<const uint8_t *>(msg.data()), msg.size());
+    bytes += frame.size();
+    server->send(connId, frame);
+  }
+  for (int i = 0; i < 200 && received < kFrames; ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT_EQ(received.load(), kFrames);
+  EXPECT_TRUE(ordered.load());
+
+  const WriteStats stats = server->writeStats();
+  EXPECT_EQ(stats.frames, static_cast<uint64_t>(kFrames));
+  EXPECT_EQ(stats.bytes, bytes);
+  // Frames queued while a write is in flight go out together
+  EXPECT_LT(stats.writes, stats.frames);
+  EXPECT_EQ(std::accumulate(stats.framesPerWrite.begin(),
+                            stats.framesPerWrite.end(), uint64_t{0}),
+            stats.writes);
+  EXPECT_GT(std::accumulate(stats.framesPerWrite.begin() + 1,
+                            stats.framesPerWrite.end(), uint64_t{0}),
+            0u);
+  LOG(INFO) << "writes: " << stats.writes
+            << ", frames per write: " << stats.averageFramesPerWrite()
+            << "\n";
+
+  client->stop();
+  server->stop();
+}
+
+TEST_F(TcpClientServerTest, MessageViews) {
+  constexpr int kFrames = 200;
+
+  auto server = TcpServer::Create(kServerTestPort5, 2);
+  server->setCodecFactory([] { return std::make_unique<SimpleMagicCodec>(); });
+  std::mutex mu;
+  std::vector<RetainedMessage> retained;
+  server->onMessageView([&](int connId, const MessageView &msg) {
+    auto frame = SimpleMagicCodec().encode(msg.begin(), msg.size());
+    server->send(connId, frame);
+    // Keep every 10th message past the callback
+    if (msg.size() > 0 && msg.data().back() == '0') {
+      std::lock_guard<std::mutex> lock(mu);
+      retained.push_back(msg.retain());
+    }
+  });
+  server->start();
+
+  std::atomic<int> received = 0;
+  std::atomic<bool> ordered = true;
+  std::atomic<bool> connected = false;
+  auto client = TcpClient::Create("127.0.0.1", kServerTestPort5);
+  client->setCodecFactory([] { return std::make_unique<SimpleMagicCodec>(); });
+  client->onConnect([&](int) { connected = true; });
+  client->onMessageView([&](const MessageView &msg) {
+    const std::string s(msg.begin(), msg.end());
+    if (s != "view-" + std::to_string(received.load())) ordered = false;
+    received++;
+  });
+  client->start();
+  for (int i = 0; i < 100 && !connected; ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  std::this_thread::sleep_for(50ms);
+  ASSERT_TRUE(connected.load());
+
+  for (int i = 0; i < kFrames; ++i) {
+    const std::string msg = "view-" + std::to_string(i);
+    auto frame = SimpleMagicCodec().encode(
+        reinterpret_cast<const uint8_t *>(msg.data()), msg.size());
+    client->send(std::span<const uint8_t>(frame));
+  }
+  for (int i = 0; i < 200 && received < kFrames; ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT_EQ(received.load(), kFrames);
+  EXPECT_TRUE(ordered.load());
+
+  client->stop();
+  server->stop();
+
+  // Retained bytes are intact although later reads went on
+  std::lock_guard<std::mutex> lock(mu);
+  ASSERT_EQ(retained.size(), static_cast<size_t>(kFrames / 10));
+  for (size_t i = 0; i < retained.size(); ++i) {
+    const auto bytes = retained[i].data();
+    EXPECT_EQ(std::string(bytes.begin(), bytes.end()),
+              "view-" + std::to_string(i * 10));
+  }
+}
+
+TEST_F(TcpClientServerTest, LineProtocolEcho) {
+  constexpr int kLines = 200;
+  const DelimiterCodec lines("\r\n");
+
+  auto server = TcpServer::Create(kServerTestPort6, 2);
+  server->setCodecFactory(makeCodecFactory<DelimiterCodec>(lines));
+  server->onMessageView([&](int connId, const MessageView &msg) {
+    std::vector<uint8_t> frame;
+    lines.encode(std::span<const uint8_t>(msg.begin(), msg.size()), frame);
+    server->send(connId, frame);
+  });
+  server->start();
+
+  std::atomic<int> received = 0;
+  std::atomic<bool> ordered = true;
+  std::atomic<bool> connected = false;
+  auto client = TcpClient::Create("127.0.0.1", kServerTestPort6);
+  client->setCodecFactory(makeCodecFactory<DelimiterCodec>(lines));
+  client->onConnect([&](int) { connected = true; });
+  client->onMessage([&](const std::vector<uint8_t> &msg) {
+    const std::string s(msg.begin(), msg.end());
+    if (s != "line " + std::to_string(received.load())) ordered = false;
+    received++;
+  });
+  client->start();
+  for (int i = 0; i < 100 && !connected; ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  std::this_thread::sleep_for(50ms);
+  ASSERT_TRUE(connected.load());
+
+  for (int i = 0; i < kLines; ++i) {
+    const std::string msg = "line " + std::to_string(i);
+    std::vector<uint8_t> frame;
+    lines.encode(
+        std::span<const uint8_t>(
+            reinterpret_cast<const uint8_t *>(msg.data()), msg.size()),
+        frame);
+    client->send(std::span<const uint8_t>(frame));
+  }
+  for (int i = 0; i < 200 && received < kLines; ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT_EQ(received.load(), kLines);
+  EXPECT_TRUE(ordered.load());
+
+  client->stop();
+  server->stop();
+}
+
 TEST_F(TcpClientServerTest, DISABLED_Reconnect) {
   auto server = TcpServer::Create(kServerTestPort2);
   server->setCodecFactory([] { return std::make_unique<SimpleMagicCodec>(); });